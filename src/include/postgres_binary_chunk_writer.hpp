@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_binary_chunk_writer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "postgres_utils.hpp"
+
+namespace duckdb {
+
+//! How the values of a column are encoded in the binary COPY format
+enum class PostgresBinaryEncoder : uint8_t {
+	BOOLEAN,
+	SMALLINT,
+	INTEGER,
+	BIGINT,
+	FLOAT,
+	DOUBLE,
+	DATE,
+	TIME,
+	TIMESTAMP,
+	INTERVAL,
+	UUID,
+	VARCHAR,
+	BLOB,
+	//! Encoded value by value by the PostgresBinaryWriter (e.g. DECIMAL, LIST, STRUCT)
+	GENERIC
+};
+
+//! Encodes chunks in the binary COPY format column by column instead of value by value
+//! The size of every row is computed first, after which every column is written into its slot of each row in a tight
+//! loop that is specialized for the type of the column
+class PostgresBinaryChunkWriter {
+public:
+	PostgresBinaryChunkWriter(PostgresCopyState &state, const vector<LogicalType> &types);
+
+	//! Encode the rows of a flattened chunk - the result is valid until the next call
+	void WriteChunk(DataChunk &chunk);
+
+	data_ptr_t GetData() {
+		return buffer.data();
+	}
+	idx_t GetSize() const {
+		return size;
+	}
+
+	static PostgresBinaryEncoder GetEncoder(const LogicalType &type);
+
+private:
+	PostgresCopyState &state;
+	//! The encoder of every column - determined once for the COPY
+	vector<PostgresBinaryEncoder> encoders;
+	//! The encoded rows - the buffer is reused between chunks
+	vector<data_t> buffer;
+	idx_t size = 0;
+	//! The size of every row, and later the offset at which the next field of every row is written
+	vector<idx_t> row_offsets;
+};
+
+} // namespace duckdb
@@ -149,6 +149,13 @@ public:
 		WriteRawInteger<uint64_t>(value.lower);
 	}
 
+	void WriteCtid(row_t row_id) {
+		// a row id holds the page index in the upper bits and the row within the page in the lower 16 bits
+		WriteRawInteger<int32_t>(sizeof(uint32_t) + sizeof(uint16_t));
+		WriteRawInteger<uint32_t>(uint32_t(row_id >> 16));
+		WriteRawInteger<uint16_t>(uint16_t(row_id & 0xFFFF));
+	}
+
 	template <class T, class OP = DecimalConversionInteger>
 	void WriteDecimal(T value, uint16_t scale) {
 		constexpr idx_t MAX_DIGITS = sizeof(T) * 4;
@@ -17,6 +17,7 @@
 namespace duckdb {
 class PostgresBinaryWriter;
 class PostgresTextWriter;
+class MemoryStream;
 struct PostgresBinaryReader;
 class PostgresSchemaEntry;
 class PostgresTableEntry;
@@ -32,6 +33,8 @@ struct OwnedPostgresConnection {
 
 	PGconn *connection;
 	mutex connection_lock;
+	//! The number of bytes of the active COPY that were queued in libpq but not sent yet
+	idx_t copy_pending_bytes = 0;
 };
 
 class PostgresConnection {
@@ -62,13 +65,21 @@ public:
 
 	vector<IndexInfo> GetIndexInfo(const string &table_name);
 
+	//! Start a COPY into a table - with freeze the rows are written as frozen, which requires the table to be created
+	//! or truncated in the current transaction
 	void BeginCopyTo(ClientContext &context, PostgresCopyState &state, PostgresCopyFormat format,
-	                 const string &schema_name, const string &table_name, const vector<string> &column_names);
+	                 const string &schema_name, const string &table_name, const vector<string> &column_names,
+	                 bool freeze = false);
 	void CopyData(data_ptr_t buffer, idx_t size);
 	void CopyData(PostgresBinaryWriter &writer);
 	void CopyData(PostgresTextWriter &writer);
 	void CopyChunk(ClientContext &context, PostgresCopyState &state, DataChunk &chunk, DataChunk &varchar_chunk);
+	//! Encode a chunk in the format of the COPY into the stream without sending it - this does not use the connection
+	static void EncodeChunk(ClientContext &context, PostgresCopyState &state, DataChunk &chunk,
+	                        DataChunk &varchar_chunk, MemoryStream &result);
 	void FinishCopyTo(PostgresCopyState &state);
+	//! End a COPY without committing its rows, e.g. after an error - this does not throw
+	void AbortCopyTo();
 
 	void BeginCopyFrom(ClientContext &context, const string &query, ExecStatusType expected_result);
 
@@ -97,6 +108,10 @@ public:
 private:
 	PGresult *PQExecute(optional_ptr<ClientContext> context, const string &query,
 	                    const PostgresParameters &params = PostgresParameters());
+	//! Block until all queued COPY data is sent
+	void FlushCopyData();
+	//! Switch the connection back to blocking mode after a COPY
+	void EndNonBlockingCopy();
 
 	shared_ptr<OwnedPostgresConnection> connection;
 	string dsn;
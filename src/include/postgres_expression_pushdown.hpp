@@ -0,0 +1,52 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_expression_pushdown.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/planner/expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+namespace duckdb {
+struct PostgresBindData;
+
+//! Maps the column references of an expression to Postgres SQL
+class PostgresColumnResolver {
+public:
+	virtual ~PostgresColumnResolver() = default;
+
+	//! Returns an empty string if the column cannot be referenced in Postgres
+	virtual string TransformColumnRef(const Expression &expr) const = 0;
+};
+
+class PostgresExpressionPushdown {
+public:
+	//! Transform an expression over the columns of a Postgres scan into Postgres SQL
+	//! Returns an empty string if the expression cannot be evaluated in Postgres with the same result as in DuckDB
+	static string TransformExpression(const Expression &expr, const LogicalGet &get,
+	                                  const PostgresBindData &bind_data);
+	//! Transform a filter predicate (comparisons, IS [NOT] NULL, AND/OR) over the columns of a Postgres scan
+	//! Returns an empty string if the predicate cannot be evaluated in Postgres with the same result as in DuckDB
+	static string TransformPredicate(const Expression &expr, const LogicalGet &get, const PostgresBindData &bind_data);
+	//! The Postgres operator of a comparison, or an empty string if the comparison has no Postgres equivalent
+	static string GetComparisonOperator(ExpressionType type);
+	//! Map an output position of the scan to its index in the column ids, or INVALID_INDEX if out of range
+	static idx_t GetColumnIndex(const LogicalGet &get, idx_t output_index);
+
+	//! Transform an expression whose column references are mapped by the resolver
+	static string TransformExpression(const Expression &expr, const PostgresColumnResolver &resolver);
+	static string TransformPredicate(const Expression &expr, const PostgresColumnResolver &resolver);
+	//! Whether values of the type are represented the same way in DuckDB and Postgres
+	static bool SupportedType(const LogicalType &type);
+
+private:
+	static string TransformConstant(const Expression &expr);
+	static string TransformCast(const Expression &expr, const PostgresColumnResolver &resolver);
+	static string TransformFunction(const Expression &expr, const PostgresColumnResolver &resolver);
+};
+
+} // namespace duckdb
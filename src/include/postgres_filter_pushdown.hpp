@@ -16,6 +16,9 @@ class PostgresFilterPushdown {
 public:
 	static string TransformFilters(const vector<column_t> &column_ids, optional_ptr<TableFilterSet> filters,
 	                               const vector<string> &names);
+	//! Transform only the filters on the given column
+	static string TransformColumnFilters(const vector<column_t> &column_ids, TableFilterSet &filters,
+	                                     const vector<string> &names, column_t column_id);
 
 private:
 	// TODO
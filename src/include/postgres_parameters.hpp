@@ -28,6 +28,9 @@ public:
 
 	PostgresParameters(vector<Oid> types_p, vector<Value> values_p);
 
+	//! Add a parameter that is already in the binary representation of the given type
+	void AddBinary(Oid type, vector<char> data);
+
 	bool Empty() const {
 		return types.empty();
 	}
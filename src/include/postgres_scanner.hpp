@@ -35,6 +35,8 @@ public:
 	string sql;
 	PostgresParameters params;
 	idx_t pages_approx = 0;
+	//! The approximate number of rows in the scanned table - -1 if unknown
+	int64_t rows_approx = -1;
 
 	vector<PostgresType> postgres_types;
 	vector<string> names;
@@ -53,13 +55,44 @@ public:
 	//! Set by postgres_query's bind when the statement returns no columns (a command like DDL, or
 	//! DML without RETURNING). InitGlobalState executes it and returns a single-row Success result.
 	bool command_only = false;
+	//! Set when the scan executes a join of other Postgres scans that was pushed into Postgres
+	bool remote_join = false;
 	idx_t max_threads = 1;
+	//! Postgres SQL for computed columns appended by projection pushdown, indexed by column id
+	//! Empty for regular table columns
+	vector<string> remote_expressions;
+	//! Columns that are still part of the scan but are no longer consumed - these are fetched as NULL
+	unordered_set<column_t> skipped_columns;
+	//! Filters that split the scan into ranges of the sort key, in the order of the pushed down ORDER BY
+	//! When set, every range is scanned by a separate task instead of splitting the scan by ctid
+	vector<string> key_ranges;
+	//! The column of which every key range holds a single value - DConstants::INVALID_INDEX if not partitioned
+	//! When set, the scan reports the value of the key range of a task as its partition value
+	column_t partition_column = DConstants::INVALID_INDEX;
+	//! The value of the partition column in every key range
+	vector<Value> partition_values;
+	//! The ctid tasks (in units of pages_per_task) that can contain rows that pass the pushed down filters
+	//! When set, only these tasks are scanned - the last task, which extends to the end of the table, is always
+	//! included
+	vector<idx_t> ctid_tasks;
+	//! TABLESAMPLE clause pushed down from a sample over the scan
+	string sample_clause;
+	//! Whether the scan only returns distinct rows (SELECT DISTINCT)
+	bool distinct = false;
+	//! Predicates of filters that DuckDB evaluates over the scan which are also evaluated in Postgres
+	vector<string> remote_filters;
 
 	dbconnector::optimizer::OrderByAndLimitBindData order_by_and_limit_bind_data;
 	dbconnector::optimizer::AggregateBindData aggregate_bind_data;
 
 public:
 	void SetTablePages(idx_t approx_num_pages);
+	void SetTableRows(int64_t approx_num_rows);
+	//! Append a computed column that is evaluated in Postgres, returns its column id
+	column_t AddRemoteExpression(string expression, const LogicalType &type);
+	bool IsRemoteExpression(column_t column_id) const {
+		return column_id < remote_expressions.size() && !remote_expressions[column_id].empty();
+	}
 
 	void SetCatalog(PostgresCatalog &catalog);
 	void SetTable(PostgresTableEntry &table);
@@ -101,6 +134,9 @@ public:
 
 	static void PrepareBind(PostgresVersion version, ClientContext &context, PostgresBindData &bind,
 	                        int64_t approx_num_pages);
+	//! Build the SELECT statement that scans the given columns for the tasks in [task_min, task_max)
+	static string GetScanQuery(const PostgresBindData &bind_data, const vector<column_t> &column_ids,
+	                           optional_ptr<TableFilterSet> filters, idx_t task_min, idx_t task_max);
 };
 
 class PostgresScanFunctionFilterPushdown : public TableFunction {
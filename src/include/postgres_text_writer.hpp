@@ -78,22 +78,99 @@ public:
 		}
 	}
 
+	//! Whether any of the 8 bytes of the word might require escaping - i.e. is a control character up to '\r', '"'
+	//! or '\\'. This is a word-at-a-time (SWAR) check, so clean runs of a string are found 8 bytes at a time
+	static bool MightRequireEscape(uint64_t word) {
+		static constexpr uint64_t ONES = 0x0101010101010101ULL;
+		static constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+		auto less_than_cr = (word - ONES * ('\r' + 1)) & ~word;
+		auto quote = word ^ (ONES * uint64_t('"'));
+		auto backslash = word ^ (ONES * uint64_t('\\'));
+		auto has_quote = (quote - ONES) & ~quote;
+		auto has_backslash = (backslash - ONES) & ~backslash;
+		return ((less_than_cr | has_quote | has_backslash) & HIGH_BITS) != 0;
+	}
+
 	void WriteVarchar(string_t value) {
 		auto size = value.GetSize();
 		auto data = value.GetData();
-		for (idx_t c = 0; c < size; c++) {
-			WriteChar(data[c]);
+		idx_t run_start = 0;
+		idx_t pos = 0;
+		for (; pos + sizeof(uint64_t) <= size; pos += sizeof(uint64_t)) {
+			if (!MightRequireEscape(Load<uint64_t>(const_data_ptr_cast(data + pos)))) {
+				continue;
+			}
+			// write the clean run in one go, and the word that might need escaping character by character
+			stream.WriteData(const_data_ptr_cast(data + run_start), pos - run_start);
+			for (idx_t c = pos; c < pos + sizeof(uint64_t); c++) {
+				WriteChar(data[c]);
+			}
+			run_start = pos + sizeof(uint64_t);
+		}
+		stream.WriteData(const_data_ptr_cast(data + run_start), pos - run_start);
+		for (; pos < size; pos++) {
+			WriteChar(data[pos]);
 		}
 	}
 
-	void WriteValue(Vector &col, idx_t r) {
-		if (col.GetType().id() != LogicalTypeId::VARCHAR) {
-			throw InternalException("Text format can only write VARCHAR columns");
+	template <class T>
+	void WriteInteger(T value) {
+		using UNSIGNED = typename std::make_unsigned<T>::type;
+		char buffer[24];
+		auto end = buffer + sizeof(buffer);
+		auto ptr = end;
+		auto unsigned_value = value < 0 ? UNSIGNED(UNSIGNED(0) - UNSIGNED(value)) : UNSIGNED(value);
+		do {
+			*--ptr = char('0' + unsigned_value % 10);
+			unsigned_value /= 10;
+		} while (unsigned_value > 0);
+		if (value < 0) {
+			*--ptr = '-';
 		}
+		stream.WriteData(const_data_ptr_cast(ptr), NumericCast<idx_t>(end - ptr));
+	}
+
+	//! Whether values of the type are written directly instead of being converted to VARCHAR first
+	static bool CanWriteDirect(const LogicalType &type) {
+		switch (type.id()) {
+		case LogicalTypeId::BOOLEAN:
+		case LogicalTypeId::SMALLINT:
+		case LogicalTypeId::INTEGER:
+		case LogicalTypeId::BIGINT:
+		case LogicalTypeId::VARCHAR:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void WriteValue(Vector &col, idx_t r) {
 		if (FlatVector::IsNull(col, r)) {
 			WriteNull();
-		} else {
+			return;
+		}
+		switch (col.GetType().id()) {
+		case LogicalTypeId::BOOLEAN:
+			if (FlatVector::GetData<bool>(col)[r]) {
+				stream.WriteData(const_data_ptr_cast("true"), 4);
+			} else {
+				stream.WriteData(const_data_ptr_cast("false"), 5);
+			}
+			break;
+		case LogicalTypeId::SMALLINT:
+			WriteInteger<int16_t>(FlatVector::GetData<int16_t>(col)[r]);
+			break;
+		case LogicalTypeId::INTEGER:
+			WriteInteger<int32_t>(FlatVector::GetData<int32_t>(col)[r]);
+			break;
+		case LogicalTypeId::BIGINT:
+			WriteInteger<int64_t>(FlatVector::GetData<int64_t>(col)[r]);
+			break;
+		case LogicalTypeId::VARCHAR:
 			WriteVarchar(FlatVector::GetData<string_t>(col)[r]);
+			break;
+		default:
+			throw InternalException("Text format cannot write columns of type %s directly", col.GetType());
 		}
 	}
 
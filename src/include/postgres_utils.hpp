@@ -49,10 +49,14 @@ struct PostgresType {
 
 enum class PostgresCopyFormat { AUTO = 0, BINARY = 1, TEXT = 2 };
 
+class PostgresBinaryChunkWriter;
+
 struct PostgresCopyState {
 	PostgresCopyFormat format = PostgresCopyFormat::AUTO;
 	bool has_null_byte_replacement = false;
 	string null_byte_replacement;
+	//! Encodes the chunks of a binary COPY - created for the first chunk
+	shared_ptr<PostgresBinaryChunkWriter> chunk_writer;
 
 	void Initialize(ClientContext &context);
 };
@@ -15,12 +15,14 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
 #include "duckdb/planner/logical_operator.hpp"
+#include <list>
 #include <mutex>
 
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/common/enums/access_mode.hpp"
 #include "postgres_aws.hpp"
 #include "postgres_connection.hpp"
+#include "storage/postgres_explain.hpp"
 #include "storage/postgres_schema_set.hpp"
 #include "storage/postgres_connection_pool.hpp"
 #include "storage/postgres_secret_storage.hpp"
@@ -121,6 +123,11 @@ public:
 
 	void ClearCache();
 
+	//! Look up the planner estimates of a previously explained query
+	bool TryGetCachedEstimate(const string &query, PostgresPlanEstimate &result);
+	//! Cache the estimates of a query - the least recently used query is evicted when the cache is full
+	void CacheEstimate(const string &query, const PostgresPlanEstimate &estimate);
+
 	//! Whether or not this catalog should search a specific type with the standard priority
 	CatalogLookupBehavior CatalogTypeLookupRule(CatalogType type) const override {
 		switch (type) {
@@ -157,6 +164,16 @@ private:
 	std::string rds_token;
 	std::chrono::steady_clock::time_point rds_token_last_refreshed;
 	std::string connection_string;
+
+	struct CachedEstimate {
+		PostgresPlanEstimate estimate;
+		//! The position of the query in explain_cache_order
+		std::list<string>::iterator order_entry;
+	};
+	std::mutex explain_cache_lock;
+	//! The cached queries, the most recently used query first
+	std::list<string> explain_cache_order;
+	unordered_map<string, CachedEstimate> explain_cache;
 };
 
 } // namespace duckdb
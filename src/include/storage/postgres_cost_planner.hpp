@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_cost_planner.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/planner/bound_result_modifier.hpp"
+#include "duckdb/planner/logical_operator.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+namespace duckdb {
+
+//! An ORDER BY over a Postgres scan - recorded before the ORDER BY is pushed into the scan
+struct PostgresOrder {
+	PostgresOrder(LogicalGet &get, const vector<BoundOrderByNode> &orders_p) : get(get) {
+		for (auto &order : orders_p) {
+			orders.push_back(order.Copy());
+		}
+	}
+
+	LogicalGet &get;
+	vector<BoundOrderByNode> orders;
+};
+
+//! ORDER BY operators over Postgres scans, keyed by the child of the ORDER BY
+using postgres_order_map_t = reference_map_t<LogicalOperator, PostgresOrder>;
+
+//! Makes pushdown decisions for Postgres scans based on the estimates of the Postgres planner (EXPLAIN)
+class PostgresCostPlanner {
+public:
+	static bool Enabled(ClientContext &context);
+	//! Record every ORDER BY over a Postgres scan - this must run before the ORDER BY is pushed into the scan
+	static void GatherOrders(LogicalOperator &op, postgres_order_map_t &result);
+	//! Sort in DuckDB instead of in Postgres when a parallel scan followed by a local sort is estimated to be cheaper
+	//! than sorting the entire table in a single Postgres query
+	static void PlanOrders(ClientContext &context, unique_ptr<LogicalOperator> &op, postgres_order_map_t &orders);
+	//! Also evaluate filters that DuckDB applies over a Postgres scan in Postgres, if this lowers the estimated cost
+	//! (e.g. because Postgres can use an index)
+	static void PlanFilters(ClientContext &context, LogicalOperator &op);
+	//! Run a scan as a single query instead of parallel ctid ranges if this is estimated to be cheaper, e.g. when the
+	//! filters of the scan can use an index
+	static void PlanParallelism(ClientContext &context, LogicalOperator &op);
+};
+
+} // namespace duckdb
@@ -0,0 +1,37 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_explain.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+class PostgresCatalog;
+
+//! Planner estimates of the top-level node of a Postgres query plan
+struct PostgresPlanEstimate {
+	double startup_cost = 0;
+	double total_cost = 0;
+	double plan_rows = 0;
+	idx_t plan_width = 0;
+};
+
+class PostgresExplain {
+public:
+	//! Get the planner estimates of a query, running EXPLAIN (FORMAT JSON) in the current transaction of the catalog
+	//! Estimates are cached per catalog by query text, so the estimates reflect the constants of the query
+	//! Returns false if Postgres could not plan the query - the transaction remains usable in that case
+	static bool TryGetEstimate(ClientContext &context, PostgresCatalog &catalog, const string &query,
+	                           PostgresPlanEstimate &result);
+	//! Extract the estimates of the top-level plan node from the output of EXPLAIN (FORMAT JSON)
+	static bool ParseEstimate(const string &explain_output, PostgresPlanEstimate &result);
+	//! The estimated cost of running the query and transferring its result to DuckDB, in Postgres cost units
+	static double EstimateTransferCost(const PostgresPlanEstimate &estimate);
+};
+
+} // namespace duckdb
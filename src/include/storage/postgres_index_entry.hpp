@@ -19,6 +19,13 @@ public:
 	PostgresIndexEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateIndexInfo &info, string table_name);
 
 	string table_name;
+	//! The access method of the index (e.g. btree, hash, gin, brin)
+	string access_method;
+	//! The leading key column of the index - empty if the leading key is an expression
+	string leading_column;
+	bool is_unique = false;
+	//! Whether the index only covers the rows that satisfy a predicate (partial index)
+	bool is_partial = false;
 
 public:
 	Identifier GetSchemaName() const override;
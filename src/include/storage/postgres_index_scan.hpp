@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_index_scan.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/planner/logical_operator.hpp"
+
+namespace duckdb {
+struct PostgresBindData;
+
+class PostgresIndexScan {
+public:
+	static bool Enabled(ClientContext &context);
+	//! Whether the column is the leading key of a (non-partial) index of the table with the given access method
+	static bool HasIndex(ClientContext &context, const PostgresBindData &bind_data, const string &access_method,
+	                     const string &column_name);
+	//! Plan scans with a selective pushed down filter on the leading column of a btree index. Splitting such a scan
+	//! into ctid ranges prevents Postgres from using the index, so based on the selectivity of the filter (estimated
+	//! from pg_stats) the scan either keeps its ctid ranges, runs as a single (index-backed) query, or is split into
+	//! ranges of the index column. Equality filters on all columns of a primary key or unique constraint always run
+	//! as a single query.
+	//! Scans that remain split into ctid ranges and have a pushed down filter on a column with a BRIN index only scan
+	//! the ranges that can contain matching rows
+	static void PlanIndexScans(ClientContext &context, LogicalOperator &op);
+};
+
+} // namespace duckdb
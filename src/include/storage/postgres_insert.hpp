@@ -19,6 +19,29 @@
 
 namespace duckdb {
 
+//! How an INSERT into a Postgres table is spread over multiple connections (the pg_parallel_insert setting)
+enum class PostgresParallelInsertMode : uint8_t {
+	//! A single COPY stream in the transaction
+	DISABLED,
+	//! Additional threads COPY into staging tables on their own connections, which are merged into the table in the
+	//! transaction
+	ATOMIC,
+	//! Additional threads COPY into the table directly on their own connections - their rows are committed when the
+	//! thread finishes, independent of the transaction
+	NON_ATOMIC
+};
+
+//! How a CREATE TABLE AS loads the new table (the pg_bulk_load setting)
+enum class PostgresBulkLoadMode : uint8_t {
+	//! A regular COPY into the new table
+	DISABLED,
+	//! COPY ... FREEZE into the new table and ANALYZE it - the rows are frozen as they are written, so they are not
+	//! rewritten by a later vacuum
+	FREEZE,
+	//! As FREEZE, but the new table is UNLOGGED during the COPY and set to LOGGED afterwards
+	UNLOGGED
+};
+
 class PostgresInsert : public PhysicalOperator {
 public:
 	//! INSERT INTO
@@ -40,6 +63,14 @@ public:
 	bool keep_copy_alive = true;
 	//! Whether to use plain INSERTs instead of COPY
 	bool use_plain_inserts = false;
+	//! Whether (and how) the COPY is spread over multiple connections
+	PostgresParallelInsertMode parallel_mode = PostgresParallelInsertMode::DISABLED;
+	//! Whether multiple threads encode the COPY data that is sent over the connection of the transaction
+	bool parallel_encoding = false;
+	//! Whether the encoded rows are sent in the order of the batches of the source, to preserve the insertion order
+	bool send_in_batch_order = false;
+	//! How the new table is loaded, in case of CREATE TABLE AS
+	PostgresBulkLoadMode bulk_load = PostgresBulkLoadMode::DISABLED;
 
 public:
 	// Source interface
@@ -68,6 +99,30 @@ public:
 		}
 	}
 
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override {
+		if (use_plain_inserts) {
+			return PhysicalOperator::GetLocalSinkState(context);
+		} else {
+			return GetLocalSinkStateCopy(context);
+		}
+	}
+
+	SinkNextBatchType NextBatch(ExecutionContext &context, OperatorSinkNextBatchInput &input) const override {
+		if (use_plain_inserts) {
+			return SinkNextBatchType::READY;
+		} else {
+			return NextBatchCopy(context, input);
+		}
+	}
+
+	SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override {
+		if (use_plain_inserts) {
+			return SinkCombineResultType::FINISHED;
+		} else {
+			return CombineCopy(context, input);
+		}
+	}
+
 	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
 	                          OperatorSinkFinalizeInput &input) const override {
 		if (use_plain_inserts) {
@@ -82,18 +137,33 @@ public:
 	}
 
 	bool ParallelSink() const override {
-		return false;
+		return (parallel_mode != PostgresParallelInsertMode::DISABLED || parallel_encoding) && !use_plain_inserts &&
+		       keep_copy_alive;
 	}
 
+	bool RequiresBatchIndex() const override {
+		return send_in_batch_order && ParallelSink();
+	}
+
+	//! Determine whether the rows are encoded in parallel and in which order they are sent, based on the input plan
+	void PlanParallelEncoding(ClientContext &context, PhysicalOperator &plan);
+
 	string GetName() const override;
 	InsertionOrderPreservingMap<string> ParamsToString() const override;
 
 private:
 	static bool UsePlainInserts(PostgresCatalog &pg_catalog, ClientContext &context);
+	static PostgresParallelInsertMode GetParallelInsertMode(PostgresCatalog &pg_catalog, ClientContext &context);
+	static bool ParallelEncodingEnabled(ClientContext &context);
+	static PostgresBulkLoadMode GetBulkLoadMode(PostgresCatalog &pg_catalog, ClientContext &context,
+	                                            const BoundCreateTableInfo &info);
 	unique_ptr<GlobalSinkState> GetGlobalSinkStateCopy(ClientContext &context) const;
+	unique_ptr<LocalSinkState> GetLocalSinkStateCopy(ExecutionContext &context) const;
 	unique_ptr<GlobalSinkState> GetGlobalSinkStatePlain(ClientContext &context) const;
 	SinkResultType SinkCopy(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const;
 	SinkResultType SinkPlain(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const;
+	SinkNextBatchType NextBatchCopy(ExecutionContext &context, OperatorSinkNextBatchInput &input) const;
+	SinkCombineResultType CombineCopy(ExecutionContext &context, OperatorSinkCombineInput &input) const;
 	SinkFinalizeType FinalizeCopy(Pipeline &pipeline, Event &event, ClientContext &context,
 	                              OperatorSinkFinalizeInput &input) const;
 	SinkFinalizeType FinalizePlain(Pipeline &pipeline, Event &event, ClientContext &context,
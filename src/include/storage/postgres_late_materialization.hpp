@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_late_materialization.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/logical_operator.hpp"
+
+namespace duckdb {
+
+//! Fetches the remaining columns of the rows that survived a filter in DuckDB by their ctid
+class PostgresFetchByCtidFunction : public TableFunction {
+public:
+	PostgresFetchByCtidFunction();
+};
+
+class PostgresLateMaterialization {
+public:
+	//! Split scans of wide tables below a filter that is evaluated in DuckDB in two phases: the scan only fetches the
+	//! ctid and the columns the filter needs, and the wide (variable-length) columns are fetched by ctid for the rows
+	//! that pass the filter
+	//! Both phases must see the same transaction snapshot, so this is not done under READ COMMITTED
+	//! This must run after the scans have been assigned a connection strategy
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+};
+
+} // namespace duckdb
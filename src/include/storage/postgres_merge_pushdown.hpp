@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_merge_pushdown.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/logical_operator.hpp"
+
+namespace duckdb {
+
+//! A statement that reads the rows of a staging table - the name of the staging table is only known at execution time
+struct PostgresStagedStatement {
+	//! The SQL before and after the name of the staging table
+	string prefix;
+	string suffix;
+
+	string ToSQL(const string &staging_table) const {
+		return prefix + staging_table + suffix;
+	}
+};
+
+//! Copies the values of every row of its child into a temporary table in Postgres, and then runs a single statement
+//! (an INSERT ... ON CONFLICT or a MERGE) that reads that table
+class PostgresStagedMerge : public PhysicalOperator {
+public:
+	PostgresStagedMerge(PhysicalPlan &physical_plan, vector<LogicalType> types, TableCatalogEntry &table,
+	                    vector<unique_ptr<Expression>> expressions, PostgresStagedStatement statement);
+
+	//! The table that is modified by the statement
+	TableCatalogEntry &table;
+	//! The values that are staged for every row - column i of the staging table is named "c<i>"
+	vector<unique_ptr<Expression>> expressions;
+	PostgresStagedStatement statement;
+
+public:
+	// Source interface
+	SourceResultType GetDataInternal(ExecutionContext &context, DataChunk &chunk,
+	                                 OperatorSourceInput &input) const override;
+
+	bool IsSource() const override {
+		return true;
+	}
+
+public:
+	// Sink interface
+	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
+	SinkResultType Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const override;
+	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                          OperatorSinkFinalizeInput &input) const override;
+
+	bool IsSink() const override {
+		return true;
+	}
+
+	bool ParallelSink() const override {
+		return false;
+	}
+
+	string GetName() const override;
+	InsertionOrderPreservingMap<string> ParamsToString() const override;
+};
+
+class PostgresMergePushdown {
+public:
+	//! Run a MERGE into a Postgres table as a single statement in Postgres over the source rows, instead of joining
+	//! the source with the table in DuckDB: a MERGE that has the shape of an upsert (which is what INSERT ... ON
+	//! CONFLICT is bound to) becomes an INSERT ... ON CONFLICT, and other MERGEs a native MERGE (Postgres 15+)
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+};
+
+} // namespace duckdb
@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_ordered_scan.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/planner/logical_operator.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+namespace duckdb {
+struct PostgresBindData;
+
+//! The leading sort key of an ORDER BY over a Postgres scan
+struct PostgresSortKey {
+	column_t column_id = DConstants::INVALID_INDEX;
+	bool descending = false;
+	bool nulls_first = false;
+};
+
+using postgres_sort_key_map_t = reference_map_t<LogicalGet, PostgresSortKey>;
+
+class PostgresOrderedScan {
+public:
+	//! Record the leading sort key of every ORDER BY over a Postgres scan - this must run before the ORDER BY is pushed
+	//! into the scan
+	static void GatherSortKeys(LogicalOperator &op, postgres_sort_key_map_t &result);
+	//! Split scans with a pushed down ORDER BY into ranges of the sort key, using the histogram bounds in pg_stats.
+	//! Every range is scanned by a separate task with the ORDER BY applied, and the batch indexes of the tasks follow
+	//! the key order so DuckDB can concatenate the results without a global sort - this requires insertion order to be
+	//! preserved
+	static void PlanKeyRanges(ClientContext &context, postgres_sort_key_map_t &sort_keys);
+	//! Create filters that split the key column at the given (ordered) histogram bounds into at most max_threads
+	//! ranges, and a range for the NULL values placed according to the NULL order of the key. Returns an empty list
+	//! if the bounds cannot be split
+	static vector<string> CreateKeyRanges(PostgresBindData &bind_data, const PostgresSortKey &key,
+	                                      const vector<string> &bounds);
+};
+
+} // namespace duckdb
@@ -0,0 +1,23 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_partitioned_scan.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/planner/logical_operator.hpp"
+
+namespace duckdb {
+
+class PostgresPartitionedScan {
+public:
+	//! Split scans below a GROUP BY on an indexed column with few distinct values into one task per value, and report
+	//! the value of every task as its partition value. DuckDB can then aggregate every partition separately without
+	//! building a global hash table
+	static void PlanPartitions(ClientContext &context, LogicalOperator &op);
+};
+
+} // namespace duckdb
@@ -13,6 +13,7 @@
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/unordered_map.hpp"
 #include "postgres_utils.hpp"
 
@@ -40,6 +41,8 @@ struct PostgresTableInfo {
 	vector<PostgresType> postgres_types;
 	vector<string> postgres_names;
 	int64_t approx_num_pages = 0;
+	//! The approximate number of rows (reltuples or n_live_tup) - -1 if unknown
+	int64_t approx_num_rows = -1;
 	unordered_map<int64_t, idx_t> attnum_to_logical;
 };
 
@@ -60,6 +63,12 @@ public:
 
 	//! Get the copy format (text or binary) that should be used when writing data to this table
 	PostgresCopyFormat GetCopyFormat(ClientContext &context);
+	//! Get the copy format that should be used when writing only the given columns of this table
+	PostgresCopyFormat GetCopyFormat(ClientContext &context, const vector<PhysicalIndex> &column_indexes);
+
+private:
+	//! Load the column statistics of the table from pg_stats
+	void LoadStatistics(ClientContext &context);
 
 public:
 	//! Postgres type annotations
@@ -70,6 +79,15 @@ public:
 	vector<string> postgres_names;
 	//! The approximate number of pages a table consumes in Postgres
 	std::atomic<int64_t> approx_num_pages;
+	//! The approximate number of rows in the table - -1 if unknown (e.g. for views)
+	std::atomic<int64_t> approx_num_rows;
+
+private:
+	mutex statistics_lock;
+	//! Whether the column statistics have been loaded - they are cached for the lifetime of the table entry
+	bool statistics_loaded = false;
+	//! The statistics of every column, loaded lazily from pg_stats
+	vector<unique_ptr<BaseStatistics>> column_statistics;
 };
 
 } // namespace duckdb
@@ -39,6 +39,10 @@ public:
 	unique_ptr<PostgresResult> Query(const string &query);
 	unique_ptr<PostgresResult> QueryWithoutTransaction(const string &query);
 	vector<unique_ptr<PostgresResult>> ExecuteQueries(ClientContext &context, const string &queries);
+	//! Run a query in the transaction within a savepoint - returns nullptr if the query fails, in which case the
+	//! transaction remains usable. local_settings (e.g. "SET LOCAL statement_timeout = 1000") only apply to the query.
+	unique_ptr<PostgresResult> TryQueryInSavepoint(ClientContext &context, const string &query,
+	                                               const string &local_settings = string());
 	static PostgresTransaction &Get(ClientContext &context, Catalog &catalog);
 	static string GetBeginTransactionQuery(PostgresIsolationLevel isolation_level, AccessMode access_mode);
 
@@ -50,6 +54,17 @@ public:
 		return transaction_state;
 	}
 	void StageStalenessSignature(PostgresCatalogSet &catalog_set, string signature);
+	//! Record that a snapshot was exported in the transaction - exported snapshots remain registered until the end of
+	//! the transaction, which rules out COPY ... FREEZE
+	void MarkSnapshotExported() {
+		exported_snapshot = true;
+	}
+	bool HasExportedSnapshot() const {
+		return exported_snapshot;
+	}
+	//! Register a table that was committed on another connection for the transaction, and that is dropped by the
+	//! transaction - if the transaction is rolled back the table is dropped after the rollback instead
+	void DropOnRollback(string qualified_table_name);
 
 private:
 	PostgresPoolConnection connection;
@@ -61,6 +76,9 @@ private:
 	reference_map_t<CatalogEntry, shared_ptr<CatalogEntry>> referenced_entries;
 	mutex pending_signatures_lock;
 	vector<pair<reference<PostgresCatalogSet>, string>> pending_signatures;
+	mutex rollback_tables_lock;
+	vector<string> rollback_tables;
+	atomic<bool> exported_snapshot {false};
 
 private:
 	//! Retrieves the connection **without** starting a transaction if none is active
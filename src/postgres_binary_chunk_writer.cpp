@@ -0,0 +1,343 @@
+#include "postgres_binary_chunk_writer.hpp"
+#include "postgres_binary_writer.hpp"
+
+namespace duckdb {
+
+static constexpr uint32_t POSTGRES_NULL_FIELD = 0xFFFFFFFF;
+
+static inline void StoreBigEndian(uint8_t value, data_ptr_t target) {
+	*target = value;
+}
+
+static inline void StoreBigEndian(uint16_t value, data_ptr_t target) {
+	Store<uint16_t>(htons(value), target);
+}
+
+static inline void StoreBigEndian(uint32_t value, data_ptr_t target) {
+	Store<uint32_t>(htonl(value), target);
+}
+
+static inline void StoreBigEndian(uint64_t value, data_ptr_t target) {
+	Store<uint64_t>(htonll(value), target);
+}
+
+struct PostgresEncodeBoolean {
+	static constexpr idx_t SIZE = sizeof(uint8_t);
+	static void Write(bool value, data_ptr_t target) {
+		StoreBigEndian(uint8_t(value ? 1 : 0), target);
+	}
+};
+
+template <class T, class UNSIGNED_TYPE>
+struct PostgresEncodeInteger {
+	static constexpr idx_t SIZE = sizeof(T);
+	static void Write(T value, data_ptr_t target) {
+		StoreBigEndian(UNSIGNED_TYPE(value), target);
+	}
+};
+
+struct PostgresEncodeFloat {
+	static constexpr idx_t SIZE = sizeof(uint32_t);
+	static void Write(float value, data_ptr_t target) {
+		StoreBigEndian(Load<uint32_t>(const_data_ptr_cast(&value)), target);
+	}
+};
+
+struct PostgresEncodeDouble {
+	static constexpr idx_t SIZE = sizeof(uint64_t);
+	static void Write(double value, data_ptr_t target) {
+		StoreBigEndian(Load<uint64_t>(const_data_ptr_cast(&value)), target);
+	}
+};
+
+struct PostgresEncodeDate {
+	static constexpr idx_t SIZE = sizeof(uint32_t);
+	static void Write(date_t value, data_ptr_t target) {
+		StoreBigEndian(PostgresBinaryWriter::DuckDBDateToPostgres(value), target);
+	}
+};
+
+struct PostgresEncodeTime {
+	static constexpr idx_t SIZE = sizeof(uint64_t);
+	static void Write(dtime_t value, data_ptr_t target) {
+		StoreBigEndian(uint64_t(value.value), target);
+	}
+};
+
+struct PostgresEncodeTimestamp {
+	static constexpr idx_t SIZE = sizeof(uint64_t);
+	static void Write(timestamp_t value, data_ptr_t target) {
+		StoreBigEndian(PostgresBinaryWriter::DuckDBTimestampToPostgres(value), target);
+	}
+};
+
+struct PostgresEncodeInterval {
+	static constexpr idx_t SIZE = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint32_t);
+	static void Write(interval_t value, data_ptr_t target) {
+		StoreBigEndian(uint64_t(value.micros), target);
+		StoreBigEndian(uint32_t(value.days), target + sizeof(uint64_t));
+		StoreBigEndian(uint32_t(value.months), target + sizeof(uint64_t) + sizeof(uint32_t));
+	}
+};
+
+struct PostgresEncodeUUID {
+	static constexpr idx_t SIZE = sizeof(uint64_t) * 2;
+	static void Write(hugeint_t value, data_ptr_t target) {
+		StoreBigEndian(uint64_t(value.upper) ^ (uint64_t(1) << 63), target);
+		StoreBigEndian(value.lower, target + sizeof(uint64_t));
+	}
+};
+
+PostgresBinaryChunkWriter::PostgresBinaryChunkWriter(PostgresCopyState &state, const vector<LogicalType> &types)
+    : state(state) {
+	for (auto &type : types) {
+		encoders.push_back(GetEncoder(type));
+	}
+}
+
+PostgresBinaryEncoder PostgresBinaryChunkWriter::GetEncoder(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		return PostgresBinaryEncoder::BOOLEAN;
+	case LogicalTypeId::SMALLINT:
+		return PostgresBinaryEncoder::SMALLINT;
+	case LogicalTypeId::INTEGER:
+		return PostgresBinaryEncoder::INTEGER;
+	case LogicalTypeId::BIGINT:
+		return PostgresBinaryEncoder::BIGINT;
+	case LogicalTypeId::FLOAT:
+		return PostgresBinaryEncoder::FLOAT;
+	case LogicalTypeId::DOUBLE:
+		return PostgresBinaryEncoder::DOUBLE;
+	case LogicalTypeId::DATE:
+		return PostgresBinaryEncoder::DATE;
+	case LogicalTypeId::TIME:
+		return PostgresBinaryEncoder::TIME;
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+		return PostgresBinaryEncoder::TIMESTAMP;
+	case LogicalTypeId::INTERVAL:
+		return PostgresBinaryEncoder::INTERVAL;
+	case LogicalTypeId::UUID:
+		return PostgresBinaryEncoder::UUID;
+	case LogicalTypeId::VARCHAR:
+		return PostgresBinaryEncoder::VARCHAR;
+	case LogicalTypeId::BLOB:
+	case LogicalTypeId::GEOMETRY:
+		return PostgresBinaryEncoder::BLOB;
+	default:
+		return PostgresBinaryEncoder::GENERIC;
+	}
+}
+
+static idx_t GetFieldSize(PostgresBinaryEncoder encoder) {
+	switch (encoder) {
+	case PostgresBinaryEncoder::BOOLEAN:
+		return PostgresEncodeBoolean::SIZE;
+	case PostgresBinaryEncoder::SMALLINT:
+		return sizeof(int16_t);
+	case PostgresBinaryEncoder::INTEGER:
+		return sizeof(int32_t);
+	case PostgresBinaryEncoder::BIGINT:
+		return sizeof(int64_t);
+	case PostgresBinaryEncoder::FLOAT:
+		return PostgresEncodeFloat::SIZE;
+	case PostgresBinaryEncoder::DOUBLE:
+		return PostgresEncodeDouble::SIZE;
+	case PostgresBinaryEncoder::DATE:
+		return PostgresEncodeDate::SIZE;
+	case PostgresBinaryEncoder::TIME:
+		return PostgresEncodeTime::SIZE;
+	case PostgresBinaryEncoder::TIMESTAMP:
+		return PostgresEncodeTimestamp::SIZE;
+	case PostgresBinaryEncoder::INTERVAL:
+		return PostgresEncodeInterval::SIZE;
+	case PostgresBinaryEncoder::UUID:
+		return PostgresEncodeUUID::SIZE;
+	default:
+		throw InternalException("Binary encoder does not have a fixed size");
+	}
+}
+
+template <class T, class OP>
+static void WriteFixedColumn(Vector &col, idx_t count, data_ptr_t buffer, vector<idx_t> &offsets) {
+	const auto field_header = htonl(uint32_t(OP::SIZE));
+	auto data = FlatVector::GetData<T>(col);
+	for (idx_t r = 0; r < count; r++) {
+		auto target = buffer + offsets[r];
+		if (FlatVector::IsNull(col, r)) {
+			Store<uint32_t>(POSTGRES_NULL_FIELD, target);
+			offsets[r] += sizeof(uint32_t);
+			continue;
+		}
+		Store<uint32_t>(field_header, target);
+		OP::Write(data[r], target + sizeof(uint32_t));
+		offsets[r] += sizeof(uint32_t) + OP::SIZE;
+	}
+}
+
+static void WriteStringColumn(Vector &col, idx_t count, data_ptr_t buffer, vector<idx_t> &offsets) {
+	auto data = FlatVector::GetData<string_t>(col);
+	for (idx_t r = 0; r < count; r++) {
+		auto target = buffer + offsets[r];
+		if (FlatVector::IsNull(col, r)) {
+			Store<uint32_t>(POSTGRES_NULL_FIELD, target);
+			offsets[r] += sizeof(uint32_t);
+			continue;
+		}
+		auto str_size = data[r].GetSize();
+		StoreBigEndian(uint32_t(str_size), target);
+		memcpy(target + sizeof(uint32_t), data[r].GetData(), str_size);
+		offsets[r] += sizeof(uint32_t) + str_size;
+	}
+}
+
+static void WriteColumn(PostgresBinaryEncoder encoder, Vector &col, idx_t count, data_ptr_t buffer,
+                        vector<idx_t> &offsets) {
+	switch (encoder) {
+	case PostgresBinaryEncoder::BOOLEAN:
+		WriteFixedColumn<bool, PostgresEncodeBoolean>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::SMALLINT:
+		WriteFixedColumn<int16_t, PostgresEncodeInteger<int16_t, uint16_t>>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::INTEGER:
+		WriteFixedColumn<int32_t, PostgresEncodeInteger<int32_t, uint32_t>>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::BIGINT:
+		WriteFixedColumn<int64_t, PostgresEncodeInteger<int64_t, uint64_t>>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::FLOAT:
+		WriteFixedColumn<float, PostgresEncodeFloat>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::DOUBLE:
+		WriteFixedColumn<double, PostgresEncodeDouble>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::DATE:
+		WriteFixedColumn<date_t, PostgresEncodeDate>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::TIME:
+		WriteFixedColumn<dtime_t, PostgresEncodeTime>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::TIMESTAMP:
+		WriteFixedColumn<timestamp_t, PostgresEncodeTimestamp>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::INTERVAL:
+		WriteFixedColumn<interval_t, PostgresEncodeInterval>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::UUID:
+		WriteFixedColumn<hugeint_t, PostgresEncodeUUID>(col, count, buffer, offsets);
+		break;
+	case PostgresBinaryEncoder::VARCHAR:
+	case PostgresBinaryEncoder::BLOB:
+		WriteStringColumn(col, count, buffer, offsets);
+		break;
+	default:
+		throw InternalException("Unsupported binary encoder for column");
+	}
+}
+
+static bool HasNullByte(Vector &col, idx_t count) {
+	auto data = FlatVector::GetData<string_t>(col);
+	for (idx_t r = 0; r < count; r++) {
+		if (!FlatVector::IsNull(col, r) && memchr(data[r].GetData(), '\0', data[r].GetSize()) != nullptr) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! A column that is encoded value by value - the encoded values are copied into the rows afterwards
+struct PostgresGenericColumn {
+	PostgresGenericColumn(PostgresCopyState &state, idx_t column_idx) : writer(state), column_idx(column_idx) {
+	}
+
+	PostgresBinaryWriter writer;
+	idx_t column_idx;
+	//! The offset of every value in the stream of the writer (and the end of the last value)
+	vector<idx_t> value_offsets;
+};
+
+void PostgresBinaryChunkWriter::WriteChunk(DataChunk &chunk) {
+	auto count = chunk.size();
+	auto column_count = chunk.ColumnCount();
+	D_ASSERT(column_count == encoders.size());
+	// compute the size of every row
+	row_offsets.assign(count, sizeof(int16_t));
+	vector<unique_ptr<PostgresGenericColumn>> generic_columns;
+	for (idx_t c = 0; c < column_count; c++) {
+		auto &col = chunk.data[c];
+		auto encoder = encoders[c];
+		if (encoder == PostgresBinaryEncoder::VARCHAR && HasNullByte(col, count)) {
+			// NULL bytes are replaced (or rejected) by the PostgresBinaryWriter
+			encoder = PostgresBinaryEncoder::GENERIC;
+		}
+		switch (encoder) {
+		case PostgresBinaryEncoder::VARCHAR:
+		case PostgresBinaryEncoder::BLOB: {
+			auto data = FlatVector::GetData<string_t>(col);
+			for (idx_t r = 0; r < count; r++) {
+				row_offsets[r] += sizeof(uint32_t) + (FlatVector::IsNull(col, r) ? 0 : data[r].GetSize());
+			}
+			break;
+		}
+		case PostgresBinaryEncoder::GENERIC: {
+			auto generic_column = make_uniq<PostgresGenericColumn>(state, c);
+			auto &writer = generic_column->writer;
+			auto &value_offsets = generic_column->value_offsets;
+			value_offsets.reserve(count + 1);
+			for (idx_t r = 0; r < count; r++) {
+				value_offsets.push_back(writer.stream.GetPosition());
+				writer.WriteValue(col, r);
+			}
+			value_offsets.push_back(writer.stream.GetPosition());
+			for (idx_t r = 0; r < count; r++) {
+				row_offsets[r] += value_offsets[r + 1] - value_offsets[r];
+			}
+			generic_columns.push_back(std::move(generic_column));
+			break;
+		}
+		default: {
+			auto field_size = GetFieldSize(encoder);
+			for (idx_t r = 0; r < count; r++) {
+				row_offsets[r] += sizeof(uint32_t) + (FlatVector::IsNull(col, r) ? 0 : field_size);
+			}
+			break;
+		}
+		}
+	}
+	// turn the row sizes into the offsets of the rows and write the field count of every row
+	size = 0;
+	for (idx_t r = 0; r < count; r++) {
+		auto row_size = row_offsets[r];
+		row_offsets[r] = size;
+		size += row_size;
+	}
+	if (buffer.size() < size) {
+		buffer.resize(size);
+	}
+	auto data = buffer.data();
+	const auto field_count = htons(uint16_t(column_count));
+	for (idx_t r = 0; r < count; r++) {
+		Store<uint16_t>(field_count, data + row_offsets[r]);
+		row_offsets[r] += sizeof(int16_t);
+	}
+	// write the columns
+	idx_t generic_idx = 0;
+	for (idx_t c = 0; c < column_count; c++) {
+		if (generic_idx < generic_columns.size() && generic_columns[generic_idx]->column_idx == c) {
+			auto &generic_column = *generic_columns[generic_idx++];
+			auto source = generic_column.writer.stream.GetData();
+			auto &value_offsets = generic_column.value_offsets;
+			for (idx_t r = 0; r < count; r++) {
+				auto value_size = value_offsets[r + 1] - value_offsets[r];
+				memcpy(data + row_offsets[r], source + value_offsets[r], value_size);
+				row_offsets[r] += value_size;
+			}
+			continue;
+		}
+		WriteColumn(encoders[c], chunk.data[c], count, data, row_offsets);
+	}
+}
+
+} // namespace duckdb
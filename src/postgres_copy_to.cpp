@@ -4,12 +4,16 @@
 #include "duckdb/common/vector/struct_vector.hpp"
 
 #include "postgres_connection.hpp"
+#include "postgres_binary_chunk_writer.hpp"
 #include "postgres_binary_writer.hpp"
 #include "postgres_text_writer.hpp"
 #include "storage/postgres_table_entry.hpp"
 
 namespace duckdb {
 
+//! The amount of COPY data that can be queued in libpq before the sink waits for it to be sent
+static constexpr idx_t COPY_MAX_PENDING_BYTES = 16ULL * 1024ULL * 1024ULL;
+
 void PostgresCopyState::Initialize(ClientContext &context) {
 	Value replacement_value;
 	if (!context.TryGetCurrentSetting("pg_null_byte_replacement", replacement_value)) {
@@ -30,7 +34,7 @@ void PostgresCopyState::Initialize(ClientContext &context) {
 
 void PostgresConnection::BeginCopyTo(ClientContext &context, PostgresCopyState &state, PostgresCopyFormat format,
                                      const string &schema_name, const string &table_name,
-                                     const vector<string> &column_names) {
+                                     const vector<string> &column_names, bool freeze) {
 	string query = "COPY ";
 	if (!schema_name.empty()) {
 		query += PostgresUtils::WriteIdentifier(schema_name) + ".";
@@ -49,6 +53,7 @@ void PostgresConnection::BeginCopyTo(ClientContext &context, PostgresCopyState &
 	query += "FROM STDIN (FORMAT ";
 	state.Initialize(context);
 	state.format = format;
+	state.chunk_writer.reset();
 	switch (state.format) {
 	case PostgresCopyFormat::BINARY:
 		query += "BINARY";
@@ -59,6 +64,9 @@ void PostgresConnection::BeginCopyTo(ClientContext &context, PostgresCopyState &
 	default:
 		throw InternalException("Unsupported type for postgres copy format");
 	}
+	if (freeze) {
+		query += ", FREEZE";
+	}
 	query += ")";
 
 	PostgresResult pg_res(PQExecute(context, query.c_str()));
@@ -67,6 +75,12 @@ void PostgresConnection::BeginCopyTo(ClientContext &context, PostgresCopyState &
 		auto error = result ? PQresultErrorMessage(result) : PQerrorMessage(GetConn());
 		throw std::runtime_error("Failed to prepare COPY \"" + query + "\": " + string(error));
 	}
+	// send the data in non-blocking mode - data that cannot be sent yet is queued in libpq, so the rows of the next
+	// chunk can be produced while the previous ones are in transit
+	if (PQsetnonblocking(GetConn(), 1) != 0) {
+		throw IOException("Failed to switch the connection to non-blocking mode: %s", PQerrorMessage(GetConn()));
+	}
+	connection->copy_pending_bytes = 0;
 	if (state.format == PostgresCopyFormat::BINARY) {
 		// binary copy requires a header
 		PostgresBinaryWriter writer(state);
@@ -75,14 +89,48 @@ void PostgresConnection::BeginCopyTo(ClientContext &context, PostgresCopyState &
 	}
 }
 
+void PostgresConnection::EndNonBlockingCopy() {
+	PQsetnonblocking(GetConn(), 0);
+	connection->copy_pending_bytes = 0;
+}
+
+void PostgresConnection::FlushCopyData() {
+	// in blocking mode PQflush waits until the socket accepts all queued data
+	PQsetnonblocking(GetConn(), 0);
+	auto result = PQflush(GetConn());
+	PQsetnonblocking(GetConn(), 1);
+	if (result != 0) {
+		EndNonBlockingCopy();
+		throw InternalException("Error during PQflush: %s", PQerrorMessage(GetConn()));
+	}
+	connection->copy_pending_bytes = 0;
+}
+
 void PostgresConnection::CopyData(data_ptr_t buffer, idx_t size) {
 	int result;
-	do {
-		result = PQputCopyData(GetConn(), (const char *)buffer, int(size));
-	} while (result == 0);
+	while ((result = PQputCopyData(GetConn(), (const char *)buffer, int(size))) == 0) {
+		// the data could not be queued - wait for the queued data to be sent
+		FlushCopyData();
+	}
 	if (result == -1) {
+		EndNonBlockingCopy();
 		throw InternalException("Error during PQputCopyData: %s", PQerrorMessage(GetConn()));
 	}
+	// send as much as the socket accepts without waiting
+	result = PQflush(GetConn());
+	if (result == -1) {
+		EndNonBlockingCopy();
+		throw InternalException("Error during PQflush: %s", PQerrorMessage(GetConn()));
+	}
+	if (result == 0) {
+		connection->copy_pending_bytes = 0;
+		return;
+	}
+	connection->copy_pending_bytes += size;
+	if (connection->copy_pending_bytes >= COPY_MAX_PENDING_BYTES) {
+		// back-pressure: the network is slower than the production of rows
+		FlushCopyData();
+	}
 }
 
 void PostgresConnection::CopyData(PostgresBinaryWriter &writer) {
@@ -105,6 +153,8 @@ void PostgresConnection::FinishCopyTo(PostgresCopyState &state) {
 		writer.WriteFooter();
 		CopyData(writer);
 	}
+	// PQputCopyEnd sends the remaining queued data in blocking mode
+	EndNonBlockingCopy();
 
 	auto result_code = PQputCopyEnd(GetConn(), nullptr);
 	if (result_code != 1) {
@@ -119,6 +169,17 @@ void PostgresConnection::FinishCopyTo(PostgresCopyState &state) {
 	}
 }
 
+void PostgresConnection::AbortCopyTo() {
+	EndNonBlockingCopy();
+	if (PQputCopyEnd(GetConn(), "COPY aborted") != 1) {
+		return;
+	}
+	// consume the error result of the COPY
+	while (auto result = PQgetResult(GetConn())) {
+		PQclear(result);
+	}
+}
+
 bool NeedsQuotes(const string &to_quote, idx_t size) {
 	// Check if the string contains list or struct specific characters, or if it's empty or starts/ends with whitespaces
 	if (size <= 0) {
@@ -295,54 +356,77 @@ void CastToPostgresVarchar(ClientContext &context, Vector &input, Vector &result
 	}
 }
 
+static PostgresBinaryChunkWriter &WriteBinaryChunk(PostgresCopyState &state, DataChunk &chunk) {
+	if (!state.chunk_writer) {
+		state.chunk_writer = make_shared_ptr<PostgresBinaryChunkWriter>(state, chunk.GetTypes());
+	}
+	state.chunk_writer->WriteChunk(chunk);
+	return *state.chunk_writer;
+}
+
+static void WriteTextChunk(ClientContext &context, PostgresTextWriter &writer, DataChunk &chunk,
+                           DataChunk &varchar_chunk) {
+	// cast columns to varchar
+	if (varchar_chunk.ColumnCount() == 0) {
+		// not initialized yet
+		vector<LogicalType> varchar_types;
+		for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+			varchar_types.push_back(LogicalType::VARCHAR);
+		}
+		varchar_chunk.Initialize(Allocator::DefaultAllocator(), varchar_types);
+	} else {
+		varchar_chunk.Reset();
+	}
+	D_ASSERT(chunk.ColumnCount() == varchar_chunk.ColumnCount());
+	// integers, booleans and strings are written directly - other types are cast to varchar first
+	vector<reference<Vector>> columns;
+	for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+		if (PostgresTextWriter::CanWriteDirect(chunk.data[c].GetType())) {
+			columns.push_back(chunk.data[c]);
+			continue;
+		}
+		CastToPostgresVarchar(context, chunk.data[c], varchar_chunk.data[c], chunk.size());
+		columns.push_back(varchar_chunk.data[c]);
+	}
+	varchar_chunk.SetChildCardinality(chunk.size());
+
+	for (idx_t r = 0; r < chunk.size(); r++) {
+		for (idx_t c = 0; c < columns.size(); c++) {
+			if (c > 0) {
+				writer.WriteSeparator();
+			}
+			writer.WriteValue(columns[c].get(), r);
+		}
+		writer.FinishRow();
+	}
+}
+
 void PostgresConnection::CopyChunk(ClientContext &context, PostgresCopyState &state, DataChunk &chunk,
                                    DataChunk &varchar_chunk) {
 	chunk.Flatten();
 
 	if (state.format == PostgresCopyFormat::BINARY) {
-		PostgresBinaryWriter writer(state);
-		for (idx_t r = 0; r < chunk.size(); r++) {
-			writer.BeginRow(chunk.ColumnCount());
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				auto &col = chunk.data[c];
-				writer.WriteValue(col, r);
-			}
-			writer.FinishRow();
-		}
-		CopyData(writer);
+		auto &writer = WriteBinaryChunk(state, chunk);
+		CopyData(writer.GetData(), writer.GetSize());
 	} else if (state.format == PostgresCopyFormat::TEXT) {
-		// cast columns to varchar
-		if (varchar_chunk.ColumnCount() == 0) {
-			// not initialized yet
-			vector<LogicalType> varchar_types;
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				varchar_types.push_back(LogicalType::VARCHAR);
-			}
-			varchar_chunk.Initialize(Allocator::DefaultAllocator(), varchar_types);
-		} else {
-			varchar_chunk.Reset();
-		}
-		D_ASSERT(chunk.ColumnCount() == varchar_chunk.ColumnCount());
-		// for text format cast to varchar first
-		for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-			CastToPostgresVarchar(context, chunk.data[c], varchar_chunk.data[c], chunk.size());
-		}
-		varchar_chunk.SetChildCardinality(chunk.size());
-
 		PostgresTextWriter writer(state);
-		for (idx_t r = 0; r < chunk.size(); r++) {
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				if (c > 0) {
-					writer.WriteSeparator();
-				}
-				D_ASSERT(varchar_chunk.data[c].GetType().id() == LogicalTypeId::VARCHAR);
-				auto &col = varchar_chunk.data[c];
-				writer.WriteValue(col, r);
-			}
-			writer.FinishRow();
-		}
+		WriteTextChunk(context, writer, chunk, varchar_chunk);
 		CopyData(writer);
 	}
 }
 
+void PostgresConnection::EncodeChunk(ClientContext &context, PostgresCopyState &state, DataChunk &chunk,
+                                     DataChunk &varchar_chunk, MemoryStream &result) {
+	chunk.Flatten();
+
+	if (state.format == PostgresCopyFormat::BINARY) {
+		auto &writer = WriteBinaryChunk(state, chunk);
+		result.WriteData(writer.GetData(), writer.GetSize());
+	} else if (state.format == PostgresCopyFormat::TEXT) {
+		PostgresTextWriter writer(state);
+		WriteTextChunk(context, writer, chunk, varchar_chunk);
+		result.WriteData(writer.stream.GetData(), writer.stream.GetPosition());
+	}
+}
+
 } // namespace duckdb
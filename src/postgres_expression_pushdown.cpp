@@ -0,0 +1,416 @@
+#include "postgres_expression_pushdown.hpp"
+
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+
+#include "postgres_scanner.hpp"
+#include "postgres_utils.hpp"
+
+namespace duckdb {
+
+bool PostgresExpressionPushdown::SupportedType(const LogicalType &type) {
+	if (type.HasAlias()) {
+		return false;
+	}
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIMESTAMP:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool IsIntegral(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool IsNumeric(const LogicalType &type) {
+	return IsIntegral(type) || type.id() == LogicalTypeId::FLOAT || type.id() == LogicalTypeId::DOUBLE;
+}
+
+static string CastToType(const string &sql, const LogicalType &type) {
+	return "CAST(" + sql + " AS " + PostgresUtils::TypeToString(type) + ")";
+}
+
+idx_t PostgresExpressionPushdown::GetColumnIndex(const LogicalGet &get, idx_t output_index) {
+	auto &column_ids = get.GetColumnIds();
+	idx_t column_index = output_index;
+	if (!get.projection_ids.empty()) {
+		if (output_index >= get.projection_ids.size()) {
+			return DConstants::INVALID_INDEX;
+		}
+		column_index = get.projection_ids[output_index];
+	}
+	if (column_index >= column_ids.size()) {
+		return DConstants::INVALID_INDEX;
+	}
+	return column_index;
+}
+
+//! Resolves column references to the columns of a Postgres scan
+class PostgresScanColumnResolver : public PostgresColumnResolver {
+public:
+	PostgresScanColumnResolver(const LogicalGet &get, const PostgresBindData &bind_data)
+	    : get(get), bind_data(bind_data) {
+	}
+
+	string TransformColumnRef(const Expression &expr) const override {
+		auto &colref = expr.Cast<BoundColumnRefExpression>();
+		if (colref.binding.table_index != get.table_index) {
+			return string();
+		}
+		auto column_index = PostgresExpressionPushdown::GetColumnIndex(get, colref.binding.column_index);
+		if (column_index == DConstants::INVALID_INDEX) {
+			return string();
+		}
+		auto column_id = get.GetColumnIds()[column_index].GetPrimaryIndex();
+		if (IsVirtualColumn(column_id) || column_id >= bind_data.names.size() ||
+		    bind_data.IsRemoteExpression(column_id)) {
+			return string();
+		}
+		if (!PostgresExpressionPushdown::SupportedType(bind_data.types[column_id])) {
+			return string();
+		}
+		auto column_name = PostgresUtils::WriteIdentifier(bind_data.names[column_id]);
+		switch (bind_data.postgres_types[column_id].info) {
+		case PostgresTypeAnnotation::STANDARD:
+			return column_name;
+		case PostgresTypeAnnotation::CAST_TO_VARCHAR:
+			// the scan reads these columns as their Postgres text representation - do the same here
+			return column_name + "::VARCHAR";
+		case PostgresTypeAnnotation::JSONB:
+			return column_name + "::VARCHAR";
+		default:
+			// e.g. bpchar (whose padding is stripped on the DuckDB side) or numeric read as double
+			return string();
+		}
+	}
+
+private:
+	const LogicalGet &get;
+	const PostgresBindData &bind_data;
+};
+
+string PostgresExpressionPushdown::TransformConstant(const Expression &expr) {
+	auto &constant = expr.Cast<BoundConstantExpression>();
+	auto &value = constant.value;
+	if (value.IsNull()) {
+		if (!SupportedType(value.type())) {
+			return string();
+		}
+		return CastToType("NULL", value.type());
+	}
+	switch (value.type().id()) {
+	case LogicalTypeId::BOOLEAN:
+		return BooleanValue::Get(value) ? "TRUE" : "FALSE";
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+		return CastToType(value.ToString(), value.type());
+	case LogicalTypeId::VARCHAR:
+		return PostgresUtils::WriteLiteral(StringValue::Get(value));
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+		// Postgres accepts the text representation of DuckDB for all values, including inf and nan
+		return CastToType(PostgresUtils::WriteLiteral(value.ToString()), value.type());
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIMESTAMP: {
+		auto str = value.ToString();
+		if (StringUtil::Contains(str, "BC")) {
+			// DuckDB and Postgres format years before the common era differently
+			return string();
+		}
+		return CastToType(PostgresUtils::WriteLiteral(str), value.type());
+	}
+	default:
+		return string();
+	}
+}
+
+string PostgresExpressionPushdown::TransformCast(const Expression &expr, const PostgresColumnResolver &resolver) {
+	auto &cast = expr.Cast<BoundCastExpression>();
+	if (cast.try_cast) {
+		return string();
+	}
+	auto &source = cast.child->return_type;
+	auto &target = cast.return_type;
+	if (!SupportedType(source) || !SupportedType(target)) {
+		return string();
+	}
+	// only allow casts where Postgres and DuckDB are guaranteed to agree on the result
+	bool safe_cast = false;
+	if (IsIntegral(source) && IsNumeric(target)) {
+		// widening integer casts, or integer to floating point
+		safe_cast = !IsIntegral(target) || GetTypeIdSize(target.InternalType()) >= GetTypeIdSize(source.InternalType());
+	} else if (source.id() == LogicalTypeId::FLOAT && target.id() == LogicalTypeId::DOUBLE) {
+		safe_cast = true;
+	} else if (source.id() == LogicalTypeId::TIMESTAMP && target.id() == LogicalTypeId::DATE) {
+		safe_cast = true;
+	} else if (source.id() == LogicalTypeId::DATE && target.id() == LogicalTypeId::TIMESTAMP) {
+		safe_cast = true;
+	}
+	if (!safe_cast) {
+		return string();
+	}
+	auto child = TransformExpression(*cast.child, resolver);
+	if (child.empty()) {
+		return string();
+	}
+	return CastToType(child, target);
+}
+
+static bool GetIntegerConstant(const Expression &expr, int64_t &result) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+		return false;
+	}
+	auto &value = expr.Cast<BoundConstantExpression>().value;
+	if (value.IsNull() || !IsIntegral(value.type())) {
+		return false;
+	}
+	result = value.GetValue<int64_t>();
+	return true;
+}
+
+string PostgresExpressionPushdown::TransformFunction(const Expression &expr, const PostgresColumnResolver &resolver) {
+	auto &func = expr.Cast<BoundFunctionExpression>();
+	auto &name = func.function.name.GetIdentifierName();
+	auto &children = func.children;
+	if (name == "substring" || name == "substr") {
+		// DuckDB and Postgres disagree on negative and zero offsets - only push down positive constant bounds
+		if (children.size() < 2 || children.size() > 3) {
+			return string();
+		}
+		if (children[0]->return_type.id() != LogicalTypeId::VARCHAR) {
+			return string();
+		}
+		int64_t offset, length;
+		if (!GetIntegerConstant(*children[1], offset) || offset < 1) {
+			return string();
+		}
+		auto str = TransformExpression(*children[0], resolver);
+		if (str.empty()) {
+			return string();
+		}
+		if (children.size() == 2) {
+			return StringUtil::Format("substr(%s, %d)", str, offset);
+		}
+		if (!GetIntegerConstant(*children[2], length) || length < 0) {
+			return string();
+		}
+		return StringUtil::Format("substr(%s, %d, %d)", str, offset, length);
+	}
+	if (name == "length" || name == "len" || name == "char_length" || name == "character_length") {
+		if (children.size() != 1 || children[0]->return_type.id() != LogicalTypeId::VARCHAR) {
+			return string();
+		}
+		auto str = TransformExpression(*children[0], resolver);
+		if (str.empty()) {
+			return string();
+		}
+		return CastToType("length(" + str + ")", func.return_type);
+	}
+	if (name == "+" || name == "-" || name == "*") {
+		// both Postgres and DuckDB raise an error on integer overflow, so these agree as long as the operand types match
+		if (!IsIntegral(func.return_type)) {
+			return string();
+		}
+		vector<string> operands;
+		for (auto &child : children) {
+			if (child->return_type != func.return_type) {
+				return string();
+			}
+			auto operand = TransformExpression(*child, resolver);
+			if (operand.empty()) {
+				return string();
+			}
+			operands.push_back(CastToType(operand, func.return_type));
+		}
+		if (operands.size() == 1 && name == "-") {
+			return "(-" + operands[0] + ")";
+		}
+		if (operands.size() != 2) {
+			return string();
+		}
+		return "(" + operands[0] + " " + name + " " + operands[1] + ")";
+	}
+	if (name == "->>" || name == "json_extract_string") {
+		// only plain object keys and array indexes - JSONPath expressions have no Postgres equivalent
+		if (children.size() != 2 || children[0]->return_type.id() != LogicalTypeId::VARCHAR) {
+			return string();
+		}
+		if (children[1]->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			return string();
+		}
+		auto &path = children[1]->Cast<BoundConstantExpression>().value;
+		if (path.IsNull()) {
+			return string();
+		}
+		string path_sql;
+		if (path.type().id() == LogicalTypeId::VARCHAR) {
+			auto &key = StringValue::Get(path);
+			if (key.empty() || key[0] == '$' || key[0] == '/') {
+				return string();
+			}
+			path_sql = PostgresUtils::WriteLiteral(key);
+		} else if (IsIntegral(path.type())) {
+			auto index = path.GetValue<int64_t>();
+			if (index < 0) {
+				return string();
+			}
+			path_sql = to_string(index);
+		} else {
+			return string();
+		}
+		auto json = TransformExpression(*children[0], resolver);
+		if (json.empty()) {
+			return string();
+		}
+		return "((" + json + ")::JSONB ->> " + path_sql + ")";
+	}
+	return string();
+}
+
+string PostgresExpressionPushdown::TransformExpression(const Expression &expr, const LogicalGet &get,
+                                                       const PostgresBindData &bind_data) {
+	return TransformExpression(expr, PostgresScanColumnResolver(get, bind_data));
+}
+
+string PostgresExpressionPushdown::TransformExpression(const Expression &expr, const PostgresColumnResolver &resolver) {
+	if (!SupportedType(expr.return_type)) {
+		return string();
+	}
+	switch (expr.GetExpressionClass()) {
+	case ExpressionClass::BOUND_COLUMN_REF:
+		return resolver.TransformColumnRef(expr);
+	case ExpressionClass::BOUND_CONSTANT:
+		return TransformConstant(expr);
+	case ExpressionClass::BOUND_CAST:
+		return TransformCast(expr, resolver);
+	case ExpressionClass::BOUND_FUNCTION:
+		return TransformFunction(expr, resolver);
+	default:
+		return string();
+	}
+}
+
+string PostgresExpressionPushdown::GetComparisonOperator(ExpressionType type) {
+	switch (type) {
+	case ExpressionType::COMPARE_EQUAL:
+		return "=";
+	case ExpressionType::COMPARE_NOTEQUAL:
+		return "<>";
+	case ExpressionType::COMPARE_LESSTHAN:
+		return "<";
+	case ExpressionType::COMPARE_GREATERTHAN:
+		return ">";
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		return "<=";
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return ">=";
+	case ExpressionType::COMPARE_DISTINCT_FROM:
+		return "IS DISTINCT FROM";
+	case ExpressionType::COMPARE_NOT_DISTINCT_FROM:
+		return "IS NOT DISTINCT FROM";
+	default:
+		return string();
+	}
+}
+
+static bool IsOrderingComparison(ExpressionType type) {
+	switch (type) {
+	case ExpressionType::COMPARE_LESSTHAN:
+	case ExpressionType::COMPARE_GREATERTHAN:
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return true;
+	default:
+		return false;
+	}
+}
+
+string PostgresExpressionPushdown::TransformPredicate(const Expression &expr, const LogicalGet &get,
+                                                      const PostgresBindData &bind_data) {
+	return TransformPredicate(expr, PostgresScanColumnResolver(get, bind_data));
+}
+
+string PostgresExpressionPushdown::TransformPredicate(const Expression &expr, const PostgresColumnResolver &resolver) {
+	switch (expr.GetExpressionClass()) {
+	case ExpressionClass::BOUND_COMPARISON: {
+		auto &comparison = expr.Cast<BoundComparisonExpression>();
+		auto op = GetComparisonOperator(expr.GetExpressionType());
+		if (op.empty() || comparison.left->return_type != comparison.right->return_type) {
+			return string();
+		}
+		if (IsOrderingComparison(expr.GetExpressionType()) &&
+		    comparison.left->return_type.id() == LogicalTypeId::VARCHAR) {
+			// string ordering depends on the collation of the Postgres column
+			return string();
+		}
+		auto left = TransformExpression(*comparison.left, resolver);
+		auto right = TransformExpression(*comparison.right, resolver);
+		if (left.empty() || right.empty()) {
+			return string();
+		}
+		return "(" + left + " " + op + " " + right + ")";
+	}
+	case ExpressionClass::BOUND_OPERATOR: {
+		auto &op = expr.Cast<BoundOperatorExpression>();
+		if (op.children.size() != 1) {
+			return string();
+		}
+		string suffix;
+		if (expr.GetExpressionType() == ExpressionType::OPERATOR_IS_NULL) {
+			suffix = " IS NULL";
+		} else if (expr.GetExpressionType() == ExpressionType::OPERATOR_IS_NOT_NULL) {
+			suffix = " IS NOT NULL";
+		} else if (expr.GetExpressionType() == ExpressionType::OPERATOR_NOT) {
+			auto child = TransformPredicate(*op.children[0], resolver);
+			return child.empty() ? string() : "(NOT " + child + ")";
+		} else {
+			return string();
+		}
+		auto child = TransformExpression(*op.children[0], resolver);
+		return child.empty() ? string() : "(" + child + suffix + ")";
+	}
+	case ExpressionClass::BOUND_CONJUNCTION: {
+		auto &conjunction = expr.Cast<BoundConjunctionExpression>();
+		auto op = expr.GetExpressionType() == ExpressionType::CONJUNCTION_AND ? " AND " : " OR ";
+		vector<string> children;
+		for (auto &child : conjunction.children) {
+			auto child_sql = TransformPredicate(*child, resolver);
+			if (child_sql.empty()) {
+				return string();
+			}
+			children.push_back(std::move(child_sql));
+		}
+		return "(" + StringUtil::Join(children, op) + ")";
+	}
+	default:
+		if (expr.return_type.id() != LogicalTypeId::BOOLEAN) {
+			return string();
+		}
+		return TransformExpression(expr, resolver);
+	}
+}
+
+} // namespace duckdb
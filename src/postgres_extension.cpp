@@ -113,6 +113,26 @@ void SetPostgresNullByteReplacement(ClientContext &context, SetScope scope, Valu
 	}
 }
 
+void SetPostgresParallelInsert(ClientContext &context, SetScope scope, Value &parameter) {
+	if (parameter.IsNull()) {
+		return;
+	}
+	auto mode = StringUtil::Lower(StringValue::Get(parameter));
+	if (mode != "disabled" && mode != "atomic" && mode != "non_atomic") {
+		throw InvalidInputException("pg_parallel_insert must be one of 'disabled', 'atomic' or 'non_atomic'");
+	}
+}
+
+void SetPostgresBulkLoad(ClientContext &context, SetScope scope, Value &parameter) {
+	if (parameter.IsNull()) {
+		return;
+	}
+	auto mode = StringUtil::Lower(StringValue::Get(parameter));
+	if (mode != "disabled" && mode != "freeze" && mode != "unlogged") {
+		throw InvalidInputException("pg_bulk_load must be one of 'disabled', 'freeze' or 'unlogged'");
+	}
+}
+
 static std::string CreatePoolNote(const std::string &option) {
 	return std::string() + "This option only applies to newly attached Postgres databases, " +
 	       "to configure a database that is already attached use " +
@@ -199,6 +219,83 @@ static void LoadInternal(ExtensionLoader &loader) {
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
 	config.AddExtensionOption("pg_order_pushdown", "Push ORDER BY and LIMIT clauses to Postgres (default: true)",
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_parallel_top_n",
+	                          "Whether or not to run a pushed down ORDER BY ... LIMIT in every parallel scan task and "
+	                          "merge the results in DuckDB, instead of running the scan in a single task",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_parallel_ordered_scan",
+	                          "Whether or not to scan a table with a pushed down ORDER BY in parallel, by splitting it "
+	                          "into ranges of the sort key based on the Postgres column statistics",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_index_aware_scan",
+	                          "Run scans with a selective filter on an indexed column as a single index-backed query "
+	                          "or in ranges of the index column instead of in parallel ctid ranges (default: true)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_brin_block_skipping",
+	                          "Only scan the ctid ranges of a parallel scan that can contain rows that pass a filter "
+	                          "on a column with a BRIN index (default: true)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_partitioned_scan",
+	                          "Scan a table below a GROUP BY on an indexed column with at most 256 distinct values, "
+	                          "each holding at most 5% of the rows according to pg_stats, in a task per value, so "
+	                          "DuckDB can aggregate every value separately (default: true)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_sample_pushdown",
+	                          "Push percentage samples (USING SAMPLE / TABLESAMPLE) into Postgres as TABLESAMPLE "
+	                          "SYSTEM or BERNOULLI (default: true)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_query_cardinality_estimates",
+	                          "Estimate the number of rows returned by postgres_query with EXPLAIN, so DuckDB can use "
+	                          "it when planning joins (default: true)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_parallel_copy_encoding",
+	                          "Encode the rows of COPY-based inserts on multiple threads and send them over the single "
+	                          "connection of the transaction, in the order of the source if preserve_insertion_order "
+	                          "is set (default: false)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_parallel_insert",
+	                          "Spread COPY-based inserts into existing tables over multiple connections of the pool: "
+	                          "'disabled', 'atomic' (additional connections copy into staging tables that are merged "
+	                          "into the table in the transaction - only with ISOLATION_LEVEL 'READ COMMITTED') or "
+	                          "'non_atomic' (additional connections copy into the table directly and commit "
+	                          "independently of the transaction). The rows of different connections are written in an "
+	                          "arbitrary order (default: disabled)",
+	                          LogicalType::VARCHAR, Value("disabled"), SetPostgresParallelInsert);
+	config.AddExtensionOption("pg_bulk_load",
+	                          "Load the new table of a CREATE TABLE AS with a COPY ... FREEZE in the transaction that "
+	                          "creates it, followed by an ANALYZE: 'disabled', 'freeze' or 'unlogged' (the table is "
+	                          "UNLOGGED during the COPY and set to LOGGED afterwards) (default: disabled)",
+	                          LogicalType::VARCHAR, Value("disabled"), SetPostgresBulkLoad);
+	config.AddExtensionOption("pg_upsert_pushdown",
+	                          "Run INSERT ... ON CONFLICT into a Postgres table as a single INSERT ... ON CONFLICT in "
+	                          "Postgres, over the new rows copied into a temporary table (default: false)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_merge_pushdown",
+	                          "Run MERGE INTO a Postgres table as a single MERGE in Postgres (15 or newer), over the "
+	                          "source rows copied into a temporary table (default: false)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_late_materialization",
+	                          "Scan only the ctid and the filter columns of a table below a filter that is evaluated "
+	                          "in DuckDB, and fetch the remaining variable-length columns by ctid for the rows that "
+	                          "pass the filter (default: false)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_cost_based_pushdown",
+	                          "Use the estimates of the Postgres planner (EXPLAIN) to decide whether to sort in "
+	                          "Postgres or in DuckDB, whether to evaluate filters in Postgres and whether to split "
+	                          "scans into parallel ctid ranges (default: false)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_distinct_pushdown",
+	                          "Push DISTINCT and duplicate-insensitive aggregates (e.g. COUNT(DISTINCT x)) over "
+	                          "Postgres scans into Postgres as SELECT DISTINCT (default: true)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_projection_pushdown",
+	                          "Evaluate simple projection expressions (e.g. substring, arithmetic) in Postgres and "
+	                          "only transfer the columns that are consumed (default: true)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_experimental_join_pushdown",
+	                          "Whether or not to push joins between tables of the same Postgres database into Postgres "
+	                          "when the Postgres planner estimates this to be cheaper",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
 	config.AddExtensionOption("pg_null_byte_replacement",
 	                          "When writing NULL bytes to Postgres, replace them with the given character",
 	                          LogicalType::VARCHAR, Value(), SetPostgresNullByteReplacement);
@@ -17,17 +17,16 @@
 
 namespace duckdb {
 
-string PostgresFilterPushdown::TransformFilters(const vector<column_t> &column_ids,
-                                                optional_ptr<TableFilterSet> filters, const vector<string> &names) {
+static string TransformFiltersInternal(const vector<column_t> &column_ids, TableFilterSet &filters,
+                                       const vector<string> &names, optional_ptr<const column_t> only_column) {
 	using namespace dbconnector;
-	if (!filters || !filters->HasFilters()) {
-		// no filters
-		return string();
-	}
 	string result;
-	for (auto &entry : *filters) {
+	for (auto &entry : filters) {
 		string column_name;
 		auto column_id = column_ids[entry.GetIndex()];
+		if (only_column && column_id != *only_column) {
+			continue;
+		}
 		if (IsVirtualColumn(column_id)) {
 			column_name = "ctid";
 		} else {
@@ -55,4 +54,21 @@ string PostgresFilterPushdown::TransformFilters(const vector<column_t> &column_i
 	return result;
 }
 
+string PostgresFilterPushdown::TransformFilters(const vector<column_t> &column_ids,
+                                                optional_ptr<TableFilterSet> filters, const vector<string> &names) {
+	if (!filters || !filters->HasFilters()) {
+		// no filters
+		return string();
+	}
+	return TransformFiltersInternal(column_ids, *filters, names, nullptr);
+}
+
+string PostgresFilterPushdown::TransformColumnFilters(const vector<column_t> &column_ids, TableFilterSet &filters,
+                                                      const vector<string> &names, column_t column_id) {
+	if (!filters.HasFilters()) {
+		return string();
+	}
+	return TransformFiltersInternal(column_ids, filters, names, &column_id);
+}
+
 } // namespace duckdb
@@ -122,4 +122,13 @@ PostgresParameters::PostgresParameters(vector<Oid> types_p, vector<Value> values
 	}
 }
 
+void PostgresParameters::AddBinary(Oid type, vector<char> data) {
+	types.push_back(type);
+	lengths.push_back(static_cast<int>(data.size()));
+	formats.push_back(FORMAT_BINARY);
+	// moving the buffer keeps its address valid when copied_values grows
+	copied_values.push_back(std::move(data));
+	value_ptrs.push_back(copied_values.back().data());
+}
+
 } // namespace duckdb
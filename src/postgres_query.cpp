@@ -7,6 +7,7 @@
 #include "duckdb/main/database_manager.hpp"
 #include "duckdb/main/attached_database.hpp"
 #include "storage/postgres_catalog.hpp"
+#include "storage/postgres_explain.hpp"
 #include "storage/postgres_transaction.hpp"
 
 namespace duckdb {
@@ -22,6 +23,14 @@ static bool ExtractFlag(TableFunctionBindInput &input, const string &name, bool
 	return default_val;
 }
 
+static bool QueryEstimatesEnabled(ClientContext &context) {
+	Value query_estimates;
+	if (context.TryGetCurrentSetting("pg_query_cardinality_estimates", query_estimates)) {
+		return BooleanValue::Get(query_estimates);
+	}
+	return true;
+}
+
 static unique_ptr<FunctionData> PGQueryBind(ClientContext &context, TableFunctionBindInput &input,
                                             vector<LogicalType> &return_types, vector<Identifier> &names) {
 	auto result = make_uniq<PostgresBindData>(context);
@@ -144,6 +153,14 @@ static unique_ptr<FunctionData> PGQueryBind(ClientContext &context, TableFunctio
 	result->params = PostgresParameters(std::move(param_types), std::move(param_values));
 	result->use_transaction = use_transaction;
 	PostgresScanFunction::PrepareBind(pg_catalog.GetPostgresVersion(), context, *result, 0);
+	if (use_transaction && result->params.Empty() && QueryEstimatesEnabled(context)) {
+		// estimate the number of result rows with the Postgres planner - a query with parameters cannot be planned
+		// without their values
+		PostgresPlanEstimate estimate;
+		if (PostgresExplain::TryGetEstimate(context, pg_catalog, result->sql, estimate)) {
+			result->SetTableRows(static_cast<int64_t>(estimate.plan_rows));
+		}
+	}
 	return std::move(result);
 }
 
@@ -156,6 +173,7 @@ PostgresQueryFunction::PostgresQueryFunction()
 	init_global = scan_function.init_global;
 	init_local = scan_function.init_local;
 	function = scan_function.function;
+	cardinality = scan_function.cardinality;
 	projection_pushdown = true;
 	global_initialization = TableFunctionInitialization::INITIALIZE_ON_SCHEDULE;
 }
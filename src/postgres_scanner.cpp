@@ -34,6 +34,8 @@ struct PostgresLocalState : public LocalTableFunctionState {
 	string col_names;
 	PostgresConnection connection;
 	idx_t batch_idx = 0;
+	//! The key range that is currently scanned
+	idx_t key_range_idx = 0;
 	PostgresPoolConnection pool_connection;
 	unique_ptr<PostgresResultReader> reader;
 
@@ -85,6 +87,9 @@ static void PostgresGetSnapshot(ClientContext &context, const PostgresBindData &
 	auto result = con.TryQuery(context, "SELECT pg_export_snapshot()");
 	if (result) {
 		gstate.snapshot = result->GetString(0, 0);
+		if (pg_catalog && bind_data.use_transaction) {
+			Transaction::Get(context, *pg_catalog).Cast<PostgresTransaction>().MarkSnapshotExported();
+		}
 	}
 }
 
@@ -141,6 +146,10 @@ PostgresBindData::PostgresBindData(ClientContext &context) {
 	}
 }
 
+void PostgresBindData::SetTableRows(int64_t approx_num_rows) {
+	this->rows_approx = approx_num_rows;
+}
+
 void PostgresBindData::SetTablePages(idx_t approx_num_pages) {
 	this->pages_approx = approx_num_pages;
 	if (!read_only || use_text_protocol) {
@@ -154,6 +163,16 @@ PostgresConnection &PostgresGlobalState::GetConnection() {
 	return connection;
 }
 
+column_t PostgresBindData::AddRemoteExpression(string expression, const LogicalType &type) {
+	column_t column_id = names.size();
+	remote_expressions.resize(column_id + 1);
+	remote_expressions[column_id] = std::move(expression);
+	names.push_back("__pg_expr_" + to_string(column_id));
+	types.push_back(type);
+	postgres_types.push_back(PostgresUtils::CreateEmptyPostgresType(type));
+	return column_id;
+}
+
 void PostgresGlobalState::SetConnection(PostgresConnection connection) {
 	this->connection = std::move(connection);
 }
@@ -195,6 +214,7 @@ static unique_ptr<FunctionData> PostgresBind(ClientContext &context, TableFuncti
 	bind_data->requires_materialization = false;
 
 	PostgresScanFunction::PrepareBind(version, context, *bind_data, info->approx_num_pages);
+	bind_data->SetTableRows(info->approx_num_rows);
 	return std::move(bind_data);
 }
 
@@ -210,55 +230,68 @@ static bool ContainsCastToVarchar(const PostgresType &type) {
 	return false;
 }
 
-static void PostgresInitInternal(ClientContext &context, const PostgresBindData *bind_data_p,
-                                 PostgresLocalState &lstate, idx_t task_min, idx_t task_max) {
-	D_ASSERT(bind_data_p);
+string PostgresScanFunction::GetScanQuery(const PostgresBindData &bind_data, const vector<column_t> &column_ids,
+                                          optional_ptr<TableFilterSet> filters, idx_t task_min, idx_t task_max) {
 	D_ASSERT(task_min <= task_max);
 
-	auto bind_data = (const PostgresBindData *)bind_data_p;
-
 	string col_names;
-	for (auto &column_id : lstate.column_ids) {
+	for (auto &column_id : column_ids) {
 		if (!col_names.empty()) {
 			col_names += ", ";
 		}
 		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
-			if (bind_data->table_name.empty() || !bind_data->emit_ctid) {
+			if (bind_data.table_name.empty() || !bind_data.emit_ctid) {
 				// count(*) over postgres_query
 				col_names += "NULL";
 			} else {
 				col_names += "ctid";
 			}
+		} else if (bind_data.skipped_columns.find(column_id) != bind_data.skipped_columns.end()) {
+			// the column is only kept around to preserve the scan layout - don't transfer it
+			col_names += "NULL";
+		} else if (bind_data.IsRemoteExpression(column_id)) {
+			col_names += bind_data.remote_expressions[column_id];
 		} else {
-			col_names += PostgresUtils::WriteIdentifier(bind_data->names[column_id]);
-			if (bind_data->postgres_types[column_id].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
+			col_names += PostgresUtils::WriteIdentifier(bind_data.names[column_id]);
+			if (bind_data.postgres_types[column_id].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
 				col_names += "::VARCHAR";
-			} else if (bind_data->types[column_id].id() == LogicalTypeId::LIST) {
-				if (bind_data->postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+			} else if (bind_data.distinct && bind_data.types[column_id].id() == LogicalTypeId::VARCHAR &&
+			           bind_data.postgres_types[column_id].info == PostgresTypeAnnotation::STANDARD) {
+				// json has no equality operator - compare strings by their text like DuckDB does
+				col_names += "::TEXT";
+			} else if (bind_data.types[column_id].id() == LogicalTypeId::LIST) {
+				if (bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
 					continue;
 				}
-				if (bind_data->postgres_types[column_id].children[0].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
+				if (bind_data.postgres_types[column_id].children[0].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
 					col_names += "::VARCHAR[]";
 				}
 			} else {
-				if (ContainsCastToVarchar(bind_data->postgres_types[column_id])) {
+				if (ContainsCastToVarchar(bind_data.postgres_types[column_id])) {
 					throw NotImplementedException("Error reading table \"%s\" - cast to varchar not implemented for "
 					                              "composite column \"%s\" (type %s)",
-					                              bind_data->table_name, bind_data->names[column_id],
-					                              bind_data->types[column_id].ToString());
+					                              bind_data.table_name, bind_data.names[column_id],
+					                              bind_data.types[column_id].ToString());
 				}
 			}
 		}
 	}
 
-	string filter_string =
-	    PostgresFilterPushdown::TransformFilters(lstate.column_ids, lstate.filters, bind_data->names);
+	string filter_string = PostgresFilterPushdown::TransformFilters(column_ids, filters, bind_data.names);
+	for (auto &remote_filter : bind_data.remote_filters) {
+		if (!filter_string.empty()) {
+			filter_string += " AND ";
+		}
+		filter_string += remote_filter;
+	}
 
 	string filter;
-
-	lstate.exec = false;
-	lstate.done = false;
-	if (bind_data->pages_approx > 0) {
+	if (!bind_data.key_ranges.empty()) {
+		// a single task covers a single key range - without a task (e.g. when materializing) we scan all ranges
+		if (task_max == task_min + 1) {
+			filter = "WHERE " + bind_data.key_ranges[task_min];
+		}
+	} else if (bind_data.pages_approx > 0) {
 		filter = StringUtil::Format("WHERE ctid BETWEEN '(%d,0)'::tid AND '(%d,0)'::tid", task_min, task_max);
 	}
 	if (!filter_string.empty()) {
@@ -269,24 +302,41 @@ static void PostgresInitInternal(ClientContext &context, const PostgresBindData
 		}
 		filter += filter_string;
 	}
+	if (bind_data.distinct) {
+		col_names = "DISTINCT " + col_names;
+	}
 	string query;
-	if (bind_data->table_name.empty()) {
-		D_ASSERT(!bind_data->sql.empty());
+	if (bind_data.table_name.empty()) {
+		D_ASSERT(!bind_data.sql.empty());
 		query =
-		    StringUtil::Format(R"(SELECT %s FROM (%s) AS __unnamed_subquery %s)", col_names, bind_data->sql, filter);
+		    StringUtil::Format(R"(SELECT %s FROM (%s) AS __unnamed_subquery %s)", col_names, bind_data.sql, filter);
 
 	} else {
-		query = StringUtil::Format(R"(SELECT %s FROM %s.%s %s)", col_names,
-		                           PostgresUtils::WriteIdentifier(bind_data->schema_name),
-		                           PostgresUtils::WriteIdentifier(bind_data->table_name), filter);
+		query = StringUtil::Format(R"(SELECT %s FROM %s.%s%s %s)", col_names,
+		                           PostgresUtils::WriteIdentifier(bind_data.schema_name),
+		                           PostgresUtils::WriteIdentifier(bind_data.table_name), bind_data.sample_clause,
+		                           filter);
 	}
-	if (!bind_data->order_by_and_limit_bind_data.order_by_clause.empty()) {
-		query += bind_data->order_by_and_limit_bind_data.order_by_clause;
+	if (!bind_data.order_by_and_limit_bind_data.order_by_clause.empty()) {
+		query += bind_data.order_by_and_limit_bind_data.order_by_clause;
 		query += " NULLS LAST";
 	}
-	if (!bind_data->order_by_and_limit_bind_data.limit_clause.empty()) {
-		query += bind_data->order_by_and_limit_bind_data.limit_clause;
+	if (!bind_data.order_by_and_limit_bind_data.limit_clause.empty()) {
+		query += bind_data.order_by_and_limit_bind_data.limit_clause;
 	}
+	return query;
+}
+
+static void PostgresInitInternal(ClientContext &context, const PostgresBindData *bind_data_p,
+                                 PostgresLocalState &lstate, idx_t task_min, idx_t task_max) {
+	D_ASSERT(bind_data_p);
+	D_ASSERT(task_min <= task_max);
+
+	auto bind_data = (const PostgresBindData *)bind_data_p;
+
+	lstate.exec = false;
+	lstate.done = false;
+	auto query = PostgresScanFunction::GetScanQuery(*bind_data, lstate.column_ids, lstate.filters, task_min, task_max);
 	if (!bind_data->use_text_protocol) {
 		query = StringUtil::Format(R"(COPY (%s) TO STDOUT (FORMAT "binary");)", query);
 	} else {
@@ -408,6 +458,32 @@ static bool PostgresParallelStateNext(ClientContext &context, const FunctionData
 
 	lock_guard<mutex> parallel_lock(gstate.lock);
 	lstate.batch_idx = gstate.batch_idx++;
+	if (!bind_data->key_ranges.empty()) {
+		// batch indexes are handed out in the order of the key ranges, which is the order of the ORDER BY
+		if (gstate.page_idx < bind_data->key_ranges.size()) {
+			lstate.key_range_idx = gstate.page_idx;
+			PostgresInitInternal(context, bind_data, lstate, gstate.page_idx, gstate.page_idx + 1);
+			gstate.page_idx++;
+			return true;
+		}
+		lstate.done = true;
+		return false;
+	}
+	if (!bind_data->ctid_tasks.empty()) {
+		// tasks that cannot contain rows that pass the filters are skipped
+		if (gstate.page_idx < bind_data->ctid_tasks.size()) {
+			auto page_min = bind_data->ctid_tasks[gstate.page_idx] * bind_data->pages_per_task;
+			auto page_max = page_min + bind_data->pages_per_task;
+			if (page_max >= bind_data->pages_approx || page_max > POSTGRES_TID_MAX) {
+				page_max = POSTGRES_TID_MAX;
+			}
+			PostgresInitInternal(context, bind_data, lstate, page_min, page_max);
+			gstate.page_idx++;
+			return true;
+		}
+		lstate.done = true;
+		return false;
+	}
 	if (gstate.page_idx < bind_data->pages_approx) {
 		auto page_max = gstate.page_idx + bind_data->pages_per_task;
 		if (page_max >= bind_data->pages_approx || page_max > POSTGRES_TID_MAX) {
@@ -552,13 +628,43 @@ static void PostgresScan(ClientContext &context, TableFunctionInput &data, DataC
 	local_state.ScanChunk(context, bind_data, gstate, output);
 }
 
-static OperatorPartitionData PostgresGetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input) {
-	if (input.partition_info.RequiresPartitionColumns()) {
-		throw InternalException("PostgresScan::GetPartitionData: partition columns not supported");
+static TablePartitionInfo PostgresGetPartitionInfo(ClientContext &context, TableFunctionPartitionInput &input) {
+	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
+	if (bind_data.partition_column == DConstants::INVALID_INDEX || bind_data.requires_materialization) {
+		return TablePartitionInfo::NOT_PARTITIONED;
+	}
+	for (auto &partition_id : input.partition_ids) {
+		if (partition_id != bind_data.partition_column) {
+			return TablePartitionInfo::NOT_PARTITIONED;
+		}
 	}
+	// every task scans the rows of a single value of the partition column
+	return TablePartitionInfo::SINGLE_VALUE_PARTITIONS;
+}
+
+static OperatorPartitionData PostgresGetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input) {
 	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
 	auto &local_state = input.local_state->Cast<PostgresLocalState>();
-	return OperatorPartitionData(local_state.batch_idx);
+	OperatorPartitionData result(local_state.batch_idx);
+	if (input.partition_info.RequiresPartitionColumns()) {
+		if (bind_data.partition_column == DConstants::INVALID_INDEX) {
+			throw InternalException("PostgresScan::GetPartitionData: scan is not partitioned");
+		}
+		for (idx_t i = 0; i < input.partition_info.partition_columns.size(); i++) {
+			result.partition_data.emplace_back(bind_data.partition_values[local_state.key_range_idx]);
+		}
+	}
+	return result;
+}
+
+static unique_ptr<BaseStatistics> PostgresScanStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                                                         column_t column_index) {
+	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
+	auto table = bind_data.GetTable();
+	if (!table || bind_data.IsRemoteExpression(column_index)) {
+		return nullptr;
+	}
+	return table->GetStatistics(context, column_index);
 }
 
 static InsertionOrderPreservingMap<string> PostgresScanToString(TableFunctionToStringInput &input) {
@@ -566,11 +672,36 @@ static InsertionOrderPreservingMap<string> PostgresScanToString(TableFunctionToS
 	InsertionOrderPreservingMap<string> result;
 	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
 	result["Table"] = bind_data.table_name;
+	if (bind_data.max_threads > 1) {
+		result["Max Threads"] = to_string(bind_data.max_threads);
+	}
+	string remote_expressions;
+	for (auto &expression : bind_data.remote_expressions) {
+		if (expression.empty()) {
+			continue;
+		}
+		if (!remote_expressions.empty()) {
+			remote_expressions += "\n";
+		}
+		remote_expressions += expression;
+	}
+	if (!remote_expressions.empty()) {
+		result["Remote Expressions"] = remote_expressions;
+	}
+	if (bind_data.partition_column != DConstants::INVALID_INDEX) {
+		result["Partition Column"] = bind_data.names[bind_data.partition_column];
+	}
 	return result;
 }
 
 unique_ptr<NodeStatistics> PostgresScanCardinality(ClientContext &context, const FunctionData *bind_data_p) {
 	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
+	if (bind_data.rows_approx > 0 || (bind_data.rows_approx == 0 && bind_data.pages_approx == 0)) {
+		// reltuples (as computed by ANALYZE or VACUUM) or the number of live rows tracked by the statistics collector
+		// filters pushed into the scan are accounted for by DuckDB based on the column statistics (from pg_stats)
+		return make_uniq<NodeStatistics>(NumericCast<idx_t>(bind_data.rows_approx));
+	}
+	// the table has not been analyzed (or this is e.g. a view) - estimate the rows from the number of pages
 	// see https://www.postgresql.org/docs/current/storage-page-layout.html
 	// pages are 8KB
 	// every page has ~24 bytes of overhead
@@ -591,7 +722,13 @@ double PostgresScanProgress(ClientContext &context, const FunctionData *bind_dat
 	auto &gstate = global_state->Cast<PostgresGlobalState>();
 
 	lock_guard<mutex> parallel_lock(gstate.lock);
-	double progress = 100 * double(gstate.page_idx) / double(bind_data.pages_approx);
+	auto task_count = bind_data.pages_approx;
+	if (!bind_data.key_ranges.empty()) {
+		task_count = bind_data.key_ranges.size();
+	} else if (!bind_data.ctid_tasks.empty()) {
+		task_count = bind_data.ctid_tasks.size();
+	}
+	double progress = 100 * double(gstate.page_idx) / double(task_count);
 	return MinValue<double>(100, progress);
 }
 
@@ -619,7 +756,9 @@ PostgresScanFunction::PostgresScanFunction()
 	serialize = PostgresScanSerialize;
 	deserialize = PostgresScanDeserialize;
 	get_partition_data = PostgresGetPartitionData;
+	get_partition_info = PostgresGetPartitionInfo;
 	cardinality = PostgresScanCardinality;
+	statistics = PostgresScanStatistics;
 	table_scan_progress = PostgresScanProgress;
 	get_bind_info = PostgresGetBindInfo;
 	projection_pushdown = true;
@@ -633,7 +772,9 @@ PostgresScanFunctionFilterPushdown::PostgresScanFunctionFilterPushdown()
 	serialize = PostgresScanSerialize;
 	deserialize = PostgresScanDeserialize;
 	get_partition_data = PostgresGetPartitionData;
+	get_partition_info = PostgresGetPartitionInfo;
 	cardinality = PostgresScanCardinality;
+	statistics = PostgresScanStatistics;
 	table_scan_progress = PostgresScanProgress;
 	get_bind_info = PostgresGetBindInfo;
 	projection_pushdown = true;
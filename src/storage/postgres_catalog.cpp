@@ -266,6 +266,43 @@ DatabaseSize PostgresCatalog::GetDatabaseSize(ClientContext &context) {
 
 void PostgresCatalog::ClearCache() {
 	schemas.ClearEntries();
+	lock_guard<mutex> guard(explain_cache_lock);
+	explain_cache.clear();
+	explain_cache_order.clear();
+}
+
+//! The maximum amount of cached query estimates
+static constexpr idx_t MAX_CACHED_ESTIMATES = 1024;
+
+bool PostgresCatalog::TryGetCachedEstimate(const string &query, PostgresPlanEstimate &result) {
+	lock_guard<mutex> guard(explain_cache_lock);
+	auto entry = explain_cache.find(query);
+	if (entry == explain_cache.end()) {
+		return false;
+	}
+	// move the query to the front of the eviction order
+	explain_cache_order.splice(explain_cache_order.begin(), explain_cache_order, entry->second.order_entry);
+	result = entry->second.estimate;
+	return true;
+}
+
+void PostgresCatalog::CacheEstimate(const string &query, const PostgresPlanEstimate &estimate) {
+	lock_guard<mutex> guard(explain_cache_lock);
+	auto entry = explain_cache.find(query);
+	if (entry != explain_cache.end()) {
+		explain_cache_order.splice(explain_cache_order.begin(), explain_cache_order, entry->second.order_entry);
+		entry->second.estimate = estimate;
+		return;
+	}
+	if (explain_cache.size() >= MAX_CACHED_ESTIMATES) {
+		// evict the least recently used query
+		explain_cache.erase(explain_cache_order.back());
+		explain_cache_order.pop_back();
+	}
+	explain_cache_order.push_front(query);
+	auto &cached = explain_cache[query];
+	cached.estimate = estimate;
+	cached.order_entry = explain_cache_order.begin();
 }
 
 void PostgresCatalog::RegisterSecretStorage() {
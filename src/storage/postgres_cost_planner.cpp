@@ -0,0 +1,205 @@
+#include "storage/postgres_cost_planner.hpp"
+
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/planner/operator/logical_order.hpp"
+
+#include "postgres_expression_pushdown.hpp"
+#include "postgres_scanner.hpp"
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_explain.hpp"
+
+namespace duckdb {
+
+//! The estimated cost (in Postgres cost units) of a single comparison of a sort in DuckDB
+//! This matches the default cpu_operator_cost of Postgres
+static constexpr double LOCAL_SORT_COST_PER_COMPARISON = 0.0025;
+
+bool PostgresCostPlanner::Enabled(ClientContext &context) {
+	Value cost_based;
+	if (context.TryGetCurrentSetting("pg_cost_based_pushdown", cost_based)) {
+		return BooleanValue::Get(cost_based);
+	}
+	return false;
+}
+
+static optional_ptr<LogicalGet> GetPostgresTableScan(LogicalOperator &op) {
+	if (op.type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = op.Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return nullptr;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!bind_data.GetCatalog() || bind_data.table_name.empty() || bind_data.command_only) {
+		return nullptr;
+	}
+	return &get;
+}
+
+static vector<column_t> GetScanColumnIds(LogicalGet &get) {
+	vector<column_t> result;
+	for (auto &column_index : get.GetColumnIds()) {
+		result.push_back(column_index.GetPrimaryIndex());
+	}
+	return result;
+}
+
+//! Estimate the query of the scan when it runs as a single task
+static bool EstimateSingleQuery(ClientContext &context, LogicalGet &get, PostgresPlanEstimate &result) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	auto pages_approx = bind_data.pages_approx;
+	bind_data.pages_approx = 0;
+	auto query = PostgresScanFunction::GetScanQuery(bind_data, GetScanColumnIds(get), &get.table_filters, 0, 0);
+	bind_data.pages_approx = pages_approx;
+	return PostgresExplain::TryGetEstimate(context, *bind_data.GetCatalog(), query, result);
+}
+
+//! Estimate the cost of the scan when it is split into ctid ranges, based on the estimate of the first range
+//! The ranges are scanned concurrently by max_threads connections
+static bool EstimateParallelCost(ClientContext &context, LogicalGet &get, double &result) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	D_ASSERT(bind_data.pages_approx > 0 && bind_data.max_threads > 1);
+	auto query = PostgresScanFunction::GetScanQuery(bind_data, GetScanColumnIds(get), &get.table_filters, 0,
+	                                                bind_data.pages_per_task);
+	PostgresPlanEstimate estimate;
+	if (!PostgresExplain::TryGetEstimate(context, *bind_data.GetCatalog(), query, estimate)) {
+		return false;
+	}
+	auto task_count = (bind_data.pages_approx + bind_data.pages_per_task - 1) / bind_data.pages_per_task;
+	auto rounds = (task_count + bind_data.max_threads - 1) / bind_data.max_threads;
+	result = double(rounds) * PostgresExplain::EstimateTransferCost(estimate);
+	return true;
+}
+
+static bool CanScanInParallel(const PostgresBindData &bind_data) {
+	return bind_data.read_only && !bind_data.use_text_protocol && bind_data.pages_approx > 0 &&
+	       bind_data.max_threads > 1 && bind_data.key_ranges.empty();
+}
+
+void PostgresCostPlanner::GatherOrders(LogicalOperator &op, postgres_order_map_t &result) {
+	if (op.type == LogicalOperatorType::LOGICAL_ORDER_BY) {
+		auto &child = *op.children[0];
+		reference<LogicalOperator> current(child);
+		while (current.get().type == LogicalOperatorType::LOGICAL_PROJECTION && current.get().children.size() == 1) {
+			current = *current.get().children[0];
+		}
+		auto get = GetPostgresTableScan(current.get());
+		if (get) {
+			result.emplace(child, PostgresOrder(*get, op.Cast<LogicalOrder>().orders));
+		}
+	}
+	for (auto &child : op.children) {
+		GatherOrders(*child, result);
+	}
+}
+
+void PostgresCostPlanner::PlanOrders(ClientContext &context, unique_ptr<LogicalOperator> &op,
+                                     postgres_order_map_t &orders) {
+	for (auto &child : op->children) {
+		if (op->type == LogicalOperatorType::LOGICAL_ORDER_BY) {
+			// the ORDER BY was not pushed into the scan
+			orders.erase(*child);
+		}
+		PlanOrders(context, child, orders);
+	}
+	auto entry = orders.find(*op);
+	if (entry == orders.end()) {
+		return;
+	}
+	auto &get = entry->second.get;
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	auto &pushed_clauses = bind_data.order_by_and_limit_bind_data;
+	if (pushed_clauses.order_by_clause.empty() || !pushed_clauses.limit_clause.empty() ||
+	    !CanScanInParallel(bind_data)) {
+		// an ORDER BY that is split into key ranges already runs in parallel
+		return;
+	}
+	// a pushed down ORDER BY runs as a single query - compare it to scanning in parallel and sorting locally
+	PostgresPlanEstimate ordered_estimate;
+	if (!EstimateSingleQuery(context, get, ordered_estimate)) {
+		return;
+	}
+	auto order_by_clause = std::move(pushed_clauses.order_by_clause);
+	pushed_clauses.order_by_clause.clear();
+	double parallel_cost;
+	auto rows = MaxValue<double>(ordered_estimate.plan_rows, 2);
+	auto local_sort_cost = rows * std::log2(rows) * LOCAL_SORT_COST_PER_COMPARISON / double(bind_data.max_threads);
+	if (!EstimateParallelCost(context, get, parallel_cost) ||
+	    PostgresExplain::EstimateTransferCost(ordered_estimate) <= parallel_cost + local_sort_cost) {
+		pushed_clauses.order_by_clause = std::move(order_by_clause);
+		return;
+	}
+	// scan in parallel and sort in DuckDB
+	auto order = make_uniq<LogicalOrder>(std::move(entry->second.orders));
+	order->children.push_back(std::move(op));
+	op = std::move(order);
+	orders.erase(entry);
+}
+
+void PostgresCostPlanner::PlanFilters(ClientContext &context, LogicalOperator &op) {
+	for (auto &child : op.children) {
+		PlanFilters(context, *child);
+	}
+	if (op.type != LogicalOperatorType::LOGICAL_FILTER) {
+		return;
+	}
+	auto get = GetPostgresTableScan(*op.children[0]);
+	if (!get) {
+		return;
+	}
+	auto &bind_data = get->bind_data->Cast<PostgresBindData>();
+	vector<string> predicates;
+	for (auto &expr : op.expressions) {
+		auto predicate = PostgresExpressionPushdown::TransformPredicate(*expr, *get, bind_data);
+		if (!predicate.empty()) {
+			predicates.push_back(std::move(predicate));
+		}
+	}
+	if (predicates.empty()) {
+		return;
+	}
+	PostgresPlanEstimate unfiltered_estimate;
+	if (!EstimateSingleQuery(context, *get, unfiltered_estimate)) {
+		return;
+	}
+	// the filter is kept in DuckDB - evaluating the predicates in Postgres only reduces the transferred rows
+	auto previous_filters = bind_data.remote_filters;
+	bind_data.remote_filters.insert(bind_data.remote_filters.end(), predicates.begin(), predicates.end());
+	PostgresPlanEstimate filtered_estimate;
+	if (!EstimateSingleQuery(context, *get, filtered_estimate) ||
+	    PostgresExplain::EstimateTransferCost(filtered_estimate) >=
+	        PostgresExplain::EstimateTransferCost(unfiltered_estimate)) {
+		bind_data.remote_filters = std::move(previous_filters);
+	}
+}
+
+void PostgresCostPlanner::PlanParallelism(ClientContext &context, LogicalOperator &op) {
+	for (auto &child : op.children) {
+		PlanParallelism(context, *child);
+	}
+	auto get = GetPostgresTableScan(op);
+	if (!get) {
+		return;
+	}
+	auto &bind_data = get->bind_data->Cast<PostgresBindData>();
+	if (!CanScanInParallel(bind_data) || !bind_data.sample_clause.empty()) {
+		return;
+	}
+	if (!get->table_filters.HasFilters() && bind_data.remote_filters.empty()) {
+		// without filters Postgres reads the entire table in either case
+		return;
+	}
+	PostgresPlanEstimate single_estimate;
+	double parallel_cost;
+	if (!EstimateSingleQuery(context, *get, single_estimate) || !EstimateParallelCost(context, *get, parallel_cost)) {
+		return;
+	}
+	if (PostgresExplain::EstimateTransferCost(single_estimate) <= parallel_cost) {
+		// e.g. an index scan - a ctid range cannot be combined with an index scan efficiently
+		bind_data.pages_approx = 0;
+		bind_data.max_threads = 1;
+	}
+}
+
+} // namespace duckdb
@@ -8,7 +8,10 @@
 #include "duckdb/planner/operator/logical_delete.hpp"
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_transaction.hpp"
+#include "postgres_binary_writer.hpp"
 #include "postgres_connection.hpp"
+#include "postgres_type_oids.hpp"
+#include "duckdb/common/types/uuid.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 
 namespace duckdb {
@@ -22,12 +25,25 @@ PostgresDelete::PostgresDelete(PhysicalPlan &physical_plan, LogicalOperator &op,
 //===--------------------------------------------------------------------===//
 // States
 //===--------------------------------------------------------------------===//
-string GetDeleteSQL(const PostgresTableEntry &table, const string &ctid_list) {
+//! The number of rows that are deleted by a single DELETE statement with an array of ctids
+//! Deletes of more rows copy the ctids into a temporary table instead
+static constexpr idx_t DELETE_BATCH_SIZE = 50000;
+
+static string GetTableName(const PostgresTableEntry &table) {
+	return PostgresUtils::WriteIdentifier(table.schema.name.GetIdentifierName()) + "." +
+	       PostgresUtils::QuotePostgresIdentifier(table.name.GetIdentifierName());
+}
+
+string GetDeleteSQL(const PostgresTableEntry &table) {
+	return "DELETE FROM " + GetTableName(table) + " WHERE ctid = ANY($1::TID[])";
+}
+
+string GetDeleteUsingSQL(const PostgresTableEntry &table, const string &delete_table_name) {
 	string result;
-	result = "DELETE FROM ";
-	result += PostgresUtils::WriteIdentifier(table.schema.name.GetIdentifierName()) + ".";
-	result += PostgresUtils::QuotePostgresIdentifier(table.name.GetIdentifierName());
-	result += " WHERE ctid IN (" + ctid_list + ")";
+	result = "DELETE FROM " + GetTableName(table);
+	result += " USING " + PostgresUtils::QuotePostgresIdentifier(delete_table_name);
+	result += " WHERE " + PostgresUtils::QuotePostgresIdentifier(table.name.GetIdentifierName());
+	result += ".ctid=" + PostgresUtils::QuotePostgresIdentifier(delete_table_name) + ".__page_id";
 	return result;
 }
 
@@ -37,23 +53,71 @@ public:
 	}
 
 	PostgresTableEntry &table;
-	string ctid_list;
+	//! The row ids that have not been sent to Postgres yet
+	vector<row_t> row_ids;
+	//! The temporary table the ctids are copied into - empty if the rows are deleted with a single statement
+	string delete_table_name;
 	idx_t delete_count;
 
+	//! Copy the buffered ctids into the temporary table
+	void CopyRowIds(ClientContext &context) {
+		auto &transaction = PostgresTransaction::Get(context, table.catalog);
+		auto &connection = transaction.GetConnection();
+		if (delete_table_name.empty()) {
+			delete_table_name = "delete_data_" + UUID::ToString(UUID::GenerateRandomUUID());
+			connection.Execute(context, "CREATE LOCAL TEMPORARY TABLE " +
+			                                PostgresUtils::QuotePostgresIdentifier(delete_table_name) +
+			                                "(__page_id TID) ON COMMIT DROP");
+		}
+		// the copy is finished right away - a MERGE can run other statements on the connection between sinks
+		PostgresCopyState copy_state;
+		connection.BeginCopyTo(context, copy_state, PostgresCopyFormat::BINARY, string(), delete_table_name,
+		                       vector<string>());
+		PostgresBinaryWriter writer(copy_state);
+		for (auto row_id : row_ids) {
+			writer.BeginRow(1);
+			writer.WriteCtid(row_id);
+			writer.FinishRow();
+		}
+		connection.CopyData(writer);
+		connection.FinishCopyTo(copy_state);
+		row_ids.clear();
+	}
+
 	void Flush(ClientContext &context) {
-		if (ctid_list.empty()) {
+		auto &transaction = PostgresTransaction::Get(context, table.catalog);
+		if (!delete_table_name.empty()) {
+			if (!row_ids.empty()) {
+				CopyRowIds(context);
+			}
+			transaction.Query(GetDeleteUsingSQL(table, delete_table_name));
 			return;
 		}
-		auto &transaction = PostgresTransaction::Get(context, table.catalog);
-		transaction.Query(GetDeleteSQL(table, ctid_list));
-		ctid_list = "";
+		if (row_ids.empty()) {
+			return;
+		}
+		// pass the ctids as a binary tid[] parameter
+		PostgresCopyState copy_state;
+		PostgresBinaryWriter writer(copy_state);
+		writer.WriteRawInteger<int32_t>(1);
+		writer.WriteRawInteger<int32_t>(0);
+		writer.WriteRawInteger<uint32_t>(TIDOID);
+		writer.WriteRawInteger<int32_t>(NumericCast<int32_t>(row_ids.size()));
+		writer.WriteRawInteger<int32_t>(1);
+		for (auto row_id : row_ids) {
+			writer.WriteCtid(row_id);
+		}
+		auto data = const_char_ptr_cast(writer.stream.GetData());
+		PostgresParameters params;
+		params.AddBinary(TIDARRAYOID, vector<char>(data, data + writer.stream.GetPosition()));
+		transaction.GetConnection().Execute(context, GetDeleteSQL(table), params);
+		row_ids.clear();
 	}
 };
 
 unique_ptr<GlobalSinkState> PostgresDelete::GetGlobalSinkState(ClientContext &context) const {
 	auto &postgres_table = table.Cast<PostgresTableEntry>();
 
-	auto &transaction = PostgresTransaction::Get(context, postgres_table.catalog);
 	auto result = make_uniq<PostgresDeleteGlobalState>(postgres_table);
 	return std::move(result);
 }
@@ -67,22 +131,10 @@ SinkResultType PostgresDelete::Sink(ExecutionContext &context, DataChunk &chunk,
 	chunk.Flatten();
 	auto &row_identifiers = chunk.data[row_id_index];
 	auto row_data = FlatVector::GetDataMutable<row_t>(row_identifiers);
-	for (idx_t i = 0; i < chunk.size(); i++) {
-		if (!gstate.ctid_list.empty()) {
-			gstate.ctid_list += ",";
-		}
-		// extract the ctid from the row id
-		auto row_in_page = row_data[i] & 0xFFFF;
-		auto page_index = row_data[i] >> 16;
-		gstate.ctid_list += "'(";
-		gstate.ctid_list += to_string(page_index);
-		gstate.ctid_list += ",";
-		gstate.ctid_list += to_string(row_in_page);
-		gstate.ctid_list += ")'";
-		if (gstate.ctid_list.size() > 3000) {
-			// avoid making too long SQL statements
-			gstate.Flush(context.client);
-		}
+	gstate.row_ids.insert(gstate.row_ids.end(), row_data, row_data + chunk.size());
+	if (gstate.row_ids.size() >= DELETE_BATCH_SIZE) {
+		// too many rows for a single statement - stage the ctids in a temporary table
+		gstate.CopyRowIds(context.client);
 	}
 	gstate.delete_count += chunk.size();
 	return SinkResultType::NEED_MORE_INPUT;
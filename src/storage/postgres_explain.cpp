@@ -0,0 +1,63 @@
+#include "storage/postgres_explain.hpp"
+
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_transaction.hpp"
+
+namespace duckdb {
+
+//! The estimated cost (in Postgres cost units) of transferring a single byte of a result to DuckDB
+//! A row of 100 bytes is weighted ten times the Postgres cpu_tuple_cost
+static constexpr double TRANSFER_COST_PER_BYTE = 0.001;
+
+static bool ExtractNumber(const string &explain_output, const string &key, double &result) {
+	// the keys of the top-level node precede the keys of its children ("Plans") in the output
+	auto search = "\"" + key + "\":";
+	auto pos = explain_output.find(search);
+	if (pos == string::npos) {
+		return false;
+	}
+	auto start = explain_output.c_str() + pos + search.size();
+	char *end;
+	result = strtod(start, &end);
+	return end != start;
+}
+
+bool PostgresExplain::ParseEstimate(const string &explain_output, PostgresPlanEstimate &result) {
+	double plan_width;
+	if (!ExtractNumber(explain_output, "Startup Cost", result.startup_cost) ||
+	    !ExtractNumber(explain_output, "Total Cost", result.total_cost) ||
+	    !ExtractNumber(explain_output, "Plan Rows", result.plan_rows) ||
+	    !ExtractNumber(explain_output, "Plan Width", plan_width)) {
+		return false;
+	}
+	result.plan_width = static_cast<idx_t>(plan_width);
+	return true;
+}
+
+static bool RunExplain(ClientContext &context, PostgresTransaction &transaction, const string &query,
+                       PostgresPlanEstimate &result) {
+	auto explain = transaction.TryQueryInSavepoint(context, "EXPLAIN (FORMAT JSON) " + query);
+	if (!explain || explain->Count() == 0) {
+		return false;
+	}
+	return PostgresExplain::ParseEstimate(explain->GetString(0, 0), result);
+}
+
+bool PostgresExplain::TryGetEstimate(ClientContext &context, PostgresCatalog &catalog, const string &query,
+                                     PostgresPlanEstimate &result) {
+	if (catalog.TryGetCachedEstimate(query, result)) {
+		return true;
+	}
+	auto &transaction = PostgresTransaction::Get(context, catalog);
+	if (!RunExplain(context, transaction, query, result)) {
+		return false;
+	}
+	catalog.CacheEstimate(query, result);
+	return true;
+}
+
+double PostgresExplain::EstimateTransferCost(const PostgresPlanEstimate &estimate) {
+	return estimate.total_cost + estimate.plan_rows * double(estimate.plan_width) * TRANSFER_COST_PER_BYTE;
+}
+
+} // namespace duckdb
@@ -0,0 +1,386 @@
+#include "storage/postgres_index_scan.hpp"
+
+#include "duckdb/parser/constraints/unique_constraint.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+#include "postgres_filter_pushdown.hpp"
+#include "postgres_scanner.hpp"
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_index_entry.hpp"
+#include "storage/postgres_ordered_scan.hpp"
+#include "storage/postgres_schema_entry.hpp"
+#include "storage/postgres_table_entry.hpp"
+#include "storage/postgres_transaction.hpp"
+
+namespace duckdb {
+
+//! Filters that select a larger fraction of the table are scanned sequentially in parallel ctid ranges
+//! Beyond a few percent of the rows the random reads of an index scan are more expensive than a sequential scan
+static constexpr double INDEX_SCAN_MAX_SELECTIVITY = 0.05;
+//! Block ranges are only looked up for filters that are estimated to select at most this fraction of the rows
+//! The lookup reads every matching row at plan time - for less selective filters it costs as much as the scan itself
+static constexpr double BLOCK_RANGE_MAX_SELECTIVITY = 0.2;
+//! The block range lookup is cancelled after this many milliseconds, in which case all ranges are scanned
+static constexpr idx_t BLOCK_RANGE_LOOKUP_TIMEOUT_MS = 1000;
+
+//! The estimated effect of the pushed down filters on an indexed column
+struct PostgresFilterEstimate {
+	column_t column_id;
+	//! The estimated fraction of the rows that pass the filters
+	double selectivity;
+	//! The histogram bounds of the column that pass the filters, in order
+	vector<string> bounds;
+};
+
+bool PostgresIndexScan::Enabled(ClientContext &context) {
+	Value index_scan;
+	if (context.TryGetCurrentSetting("pg_index_aware_scan", index_scan)) {
+		return BooleanValue::Get(index_scan);
+	}
+	return true;
+}
+
+static bool BlockRangeSkippingEnabled(ClientContext &context) {
+	Value block_skipping;
+	if (context.TryGetCurrentSetting("pg_brin_block_skipping", block_skipping)) {
+		return BooleanValue::Get(block_skipping);
+	}
+	return true;
+}
+
+//! Whether the scan is a table scan that is split into ctid ranges
+static bool IsParallelTableScan(const PostgresBindData &bind_data) {
+	if (!bind_data.GetCatalog() || !bind_data.GetTable() || bind_data.table_name.empty() || bind_data.command_only ||
+	    !bind_data.read_only || bind_data.use_text_protocol) {
+		return false;
+	}
+	if (bind_data.pages_approx == 0 || bind_data.max_threads <= 1 || !bind_data.key_ranges.empty() ||
+	    !bind_data.sample_clause.empty()) {
+		return false;
+	}
+	auto &pushed_clauses = bind_data.order_by_and_limit_bind_data;
+	return pushed_clauses.order_by_clause.empty() && pushed_clauses.limit_clause.empty();
+}
+
+bool PostgresIndexScan::HasIndex(ClientContext &context, const PostgresBindData &bind_data,
+                                 const string &access_method, const string &column_name) {
+	auto &schema = bind_data.GetTable()->schema.Cast<PostgresSchemaEntry>();
+	bool result = false;
+	schema.Scan(context, CatalogType::INDEX_ENTRY, [&](CatalogEntry &entry) {
+		auto &index = entry.Cast<PostgresIndexEntry>();
+		if (index.table_name == bind_data.table_name && index.access_method == access_method && !index.is_partial &&
+		    index.leading_column == column_name) {
+			result = true;
+		}
+	});
+	return result;
+}
+
+static string GetStatsCondition(const PostgresBindData &bind_data, column_t column_id) {
+	return StringUtil::Format("stats.schemaname = %s AND stats.tablename = %s AND stats.attname = %s",
+	                          PostgresUtils::WriteLiteral(bind_data.schema_name),
+	                          PostgresUtils::WriteLiteral(bind_data.table_name),
+	                          PostgresUtils::WriteLiteral(bind_data.names[column_id]));
+}
+
+//! Evaluate the filter on the most common values and the histogram bounds of the column in Postgres
+//! Returns nullptr if the query fails (e.g. if the statistics cannot be cast to the column type)
+static unique_ptr<PostgresResult> EvaluateFilterOnStats(ClientContext &context, PostgresTransaction &transaction,
+                                                        const PostgresBindData &bind_data, column_t column_id,
+                                                        const string &type_name, const string &filter) {
+	auto column = PostgresUtils::WriteIdentifier(bind_data.names[column_id]);
+	auto query = StringUtil::Format(
+	    R"(WITH stats AS (
+	SELECT most_common_vals::text AS __pg_mcv, most_common_freqs AS __pg_mcf, histogram_bounds::text AS __pg_hist
+	FROM pg_stats stats WHERE %s
+	ORDER BY inherited DESC LIMIT 1
+)
+SELECT NULL::text, (
+	SELECT COALESCE(sum(__pg_freq), 0) FROM stats, unnest(stats.__pg_mcv::%s[], stats.__pg_mcf) AS mcv(%s, __pg_freq)
+	WHERE %s
+)::float8, 0::bigint
+UNION ALL
+SELECT hist.%s::text, NULL, hist.__pg_idx
+FROM stats, unnest(stats.__pg_hist::%s[]) WITH ORDINALITY AS hist(%s, __pg_idx)
+WHERE %s
+ORDER BY 3)",
+	    GetStatsCondition(bind_data, column_id), type_name, column, filter, column, type_name, column, filter);
+	return transaction.TryQueryInSavepoint(context, query);
+}
+
+static bool EstimateFilter(ClientContext &context, LogicalGet &get, column_t column_id,
+                           PostgresFilterEstimate &result) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	vector<column_t> column_ids;
+	for (auto &column_index : get.GetColumnIds()) {
+		column_ids.push_back(column_index.GetPrimaryIndex());
+	}
+	auto filter =
+	    PostgresFilterPushdown::TransformColumnFilters(column_ids, get.table_filters, bind_data.names, column_id);
+	if (filter.empty()) {
+		return false;
+	}
+	auto &transaction = PostgresTransaction::Get(context, *bind_data.GetCatalog());
+	auto stats = transaction.Query(StringUtil::Format(
+	    R"(SELECT format_type(pg_attribute.atttypid, pg_attribute.atttypmod), pg_class.reltuples, stats.null_frac,
+       stats.n_distinct, COALESCE(array_length(stats.most_common_freqs, 1), 0),
+       COALESCE((SELECT sum(freq) FROM unnest(stats.most_common_freqs) AS mcf(freq)), 0),
+       COALESCE(array_length(stats.histogram_bounds::text::text[], 1), 0)
+FROM pg_stats stats
+JOIN pg_namespace ON (pg_namespace.nspname=stats.schemaname)
+JOIN pg_class ON (pg_class.relnamespace=pg_namespace.oid AND pg_class.relname=stats.tablename)
+JOIN pg_attribute ON (pg_attribute.attrelid=pg_class.oid AND pg_attribute.attname=stats.attname)
+WHERE %s
+ORDER BY stats.inherited DESC LIMIT 1)",
+	    GetStatsCondition(bind_data, column_id)));
+	if (stats->Count() == 0) {
+		// the table has not been analyzed
+		return false;
+	}
+	auto type_name = stats->GetString(0, 0);
+	auto reltuples = stats->GetDouble(0, 1);
+	auto null_frac = stats->GetDouble(0, 2);
+	auto n_distinct = stats->GetDouble(0, 3);
+	auto mcv_count = stats->GetDouble(0, 4);
+	auto mcv_freq = stats->GetDouble(0, 5);
+	auto bound_count = stats->GetInt64(0, 6);
+	if (reltuples <= 0) {
+		return false;
+	}
+	auto matches = EvaluateFilterOnStats(context, transaction, bind_data, column_id, type_name, filter);
+	if (!matches || matches->Count() == 0) {
+		return false;
+	}
+	auto mcv_match = matches->GetDouble(0, 1);
+	result.column_id = column_id;
+	result.bounds.clear();
+	for (idx_t row = 1; row < matches->Count(); row++) {
+		result.bounds.push_back(matches->GetString(row, 0));
+	}
+	// the values that are not among the most common values are distributed over the histogram
+	auto other_freq = MaxValue<double>(1 - null_frac - mcv_freq, 0);
+	double other_selectivity;
+	if (result.bounds.empty() || bound_count < 2) {
+		// the filter falls within a single bucket - assume it selects a single distinct value
+		auto distinct = n_distinct >= 0 ? n_distinct : -n_distinct * reltuples;
+		other_selectivity = other_freq / MaxValue<double>(distinct - mcv_count, 1);
+	} else {
+		// the histogram is equi-depth - every bucket holds the same fraction of the values
+		auto buckets = MinValue<double>(double(result.bounds.size()), double(bound_count - 1));
+		other_selectivity = other_freq * buckets / double(bound_count - 1);
+	}
+	result.selectivity = MinValue<double>(mcv_match + other_selectivity, 1);
+	return true;
+}
+
+//! Whether the filter on a column restricts it to a single constant value
+static bool IsEqualityFilter(const TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON:
+		return filter.Cast<ConstantFilter>().comparison_type == ExpressionType::COMPARE_EQUAL;
+	case TableFilterType::IN_FILTER:
+		return filter.Cast<InFilter>().values.size() == 1;
+	case TableFilterType::CONJUNCTION_AND: {
+		// e.g. an equality comparison combined with an IS NOT NULL filter
+		auto &conjunction = filter.Cast<ConjunctionAndFilter>();
+		for (auto &child : conjunction.child_filters) {
+			if (IsEqualityFilter(*child)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	default:
+		return false;
+	}
+}
+
+//! Whether the pushed down filters select a single row through a primary key or unique constraint
+static bool IsPointLookup(LogicalGet &get) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	auto &table = *bind_data.GetTable();
+	vector<column_t> column_ids;
+	unordered_set<column_t> equality_columns;
+	for (auto &column_index : get.GetColumnIds()) {
+		column_ids.push_back(column_index.GetPrimaryIndex());
+	}
+	for (auto &entry : get.table_filters) {
+		auto column_id = column_ids[entry.GetIndex()];
+		if (!IsVirtualColumn(column_id) && !bind_data.IsRemoteExpression(column_id) &&
+		    IsEqualityFilter(entry.Filter())) {
+			equality_columns.insert(column_id);
+		}
+	}
+	for (auto &constraint : table.GetConstraints()) {
+		if (constraint->type != ConstraintType::UNIQUE) {
+			continue;
+		}
+		auto &unique = constraint->Cast<UniqueConstraint>();
+		vector<column_t> key_columns;
+		if (unique.HasIndex()) {
+			key_columns.push_back(unique.GetIndex().index);
+		} else {
+			for (auto &name : unique.GetColumnNames()) {
+				key_columns.push_back(table.GetColumns().GetColumn(name).Logical().index);
+			}
+		}
+		bool covered = !key_columns.empty();
+		for (auto key_column : key_columns) {
+			if (equality_columns.find(key_column) == equality_columns.end()) {
+				covered = false;
+				break;
+			}
+		}
+		if (covered) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! Run a scan whose filters select at most one row as a single query on the transaction connection, without
+//! estimating the filters, exporting a snapshot or opening additional connections
+static void PlanPointLookup(LogicalGet &get) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!IsParallelTableScan(bind_data) || !get.table_filters.HasFilters() || !IsPointLookup(get)) {
+		return;
+	}
+	bind_data.pages_approx = 0;
+	bind_data.max_threads = 1;
+}
+
+static void PlanIndexScan(ClientContext &context, LogicalGet &get) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!IsParallelTableScan(bind_data) || !get.table_filters.HasFilters()) {
+		return;
+	}
+	auto &column_ids = get.GetColumnIds();
+	unordered_set<column_t> filter_columns;
+	for (auto &entry : get.table_filters) {
+		filter_columns.insert(column_ids[entry.GetIndex()].GetPrimaryIndex());
+	}
+	// find the most selective filter on an indexed column
+	unique_ptr<PostgresFilterEstimate> best;
+	for (auto column_id : filter_columns) {
+		if (IsVirtualColumn(column_id) || bind_data.IsRemoteExpression(column_id) ||
+		    bind_data.types[column_id].IsNested() ||
+		    bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+			continue;
+		}
+		if (!PostgresIndexScan::HasIndex(context, bind_data, "btree", bind_data.names[column_id])) {
+			continue;
+		}
+		auto estimate = make_uniq<PostgresFilterEstimate>();
+		if (!EstimateFilter(context, get, column_id, *estimate)) {
+			continue;
+		}
+		if (!best || estimate->selectivity < best->selectivity) {
+			best = std::move(estimate);
+		}
+	}
+	if (!best || best->selectivity > INDEX_SCAN_MAX_SELECTIVITY) {
+		// a sequential scan split into ctid ranges reads the table in parallel
+		return;
+	}
+	// split the index range into tasks of roughly pages_per_task pages each
+	auto matching_pages = best->selectivity * double(bind_data.pages_approx);
+	auto task_count = idx_t(matching_pages / double(bind_data.pages_per_task));
+	if (task_count > 1) {
+		PostgresSortKey key;
+		key.column_id = best->column_id;
+		auto max_threads = bind_data.max_threads;
+		bind_data.max_threads = MinValue<idx_t>(max_threads, task_count);
+		bind_data.key_ranges = PostgresOrderedScan::CreateKeyRanges(bind_data, key, best->bounds);
+		if (!bind_data.key_ranges.empty()) {
+			bind_data.max_threads = MinValue<idx_t>(bind_data.max_threads, bind_data.key_ranges.size());
+			return;
+		}
+		bind_data.max_threads = max_threads;
+	}
+	// run a single query so Postgres can use the index
+	bind_data.pages_approx = 0;
+	bind_data.max_threads = 1;
+}
+
+//! Restrict a scan that is split into ctid ranges to the ranges that contain rows that pass the pushed down filters,
+//! if one of the filters can use a BRIN index
+static void PlanBlockRanges(ClientContext &context, LogicalGet &get) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!IsParallelTableScan(bind_data) || !get.table_filters.HasFilters()) {
+		return;
+	}
+	vector<column_t> column_ids;
+	for (auto &column_index : get.GetColumnIds()) {
+		column_ids.push_back(column_index.GetPrimaryIndex());
+	}
+	// only look up the block ranges if a filter on a BRIN-indexed column is estimated to be selective
+	bool has_selective_brin_filter = false;
+	for (auto &entry : get.table_filters) {
+		auto column_id = column_ids[entry.GetIndex()];
+		if (IsVirtualColumn(column_id) || bind_data.IsRemoteExpression(column_id) ||
+		    !PostgresIndexScan::HasIndex(context, bind_data, "brin", bind_data.names[column_id])) {
+			continue;
+		}
+		PostgresFilterEstimate estimate;
+		if (EstimateFilter(context, get, column_id, estimate) && estimate.selectivity <= BLOCK_RANGE_MAX_SELECTIVITY) {
+			has_selective_brin_filter = true;
+			break;
+		}
+	}
+	if (!has_selective_brin_filter) {
+		return;
+	}
+	auto filter = PostgresFilterPushdown::TransformFilters(column_ids, &get.table_filters, bind_data.names);
+	if (filter.empty()) {
+		return;
+	}
+	// the last task extends to the end of the table, which might have grown since relpages was updated
+	auto last_task = (bind_data.pages_approx - 1) / bind_data.pages_per_task;
+	// the bitmap of the BRIN index only visits the block ranges whose summary matches the filters
+	auto query = StringUtil::Format(
+	    "SELECT DISTINCT (ctid::text::point)[0]::bigint / %llu FROM %s.%s WHERE %s ORDER BY 1 LIMIT %llu",
+	    bind_data.pages_per_task, PostgresUtils::WriteIdentifier(bind_data.schema_name),
+	    PostgresUtils::WriteIdentifier(bind_data.table_name), filter, last_task + 1);
+	auto &transaction = PostgresTransaction::Get(context, *bind_data.GetCatalog());
+	auto result = transaction.TryQueryInSavepoint(
+	    context, query, StringUtil::Format("SET LOCAL statement_timeout = %llu", BLOCK_RANGE_LOOKUP_TIMEOUT_MS));
+	if (!result) {
+		return;
+	}
+	vector<idx_t> ctid_tasks;
+	for (idx_t row = 0; row < result->Count(); row++) {
+		auto task = NumericCast<idx_t>(result->GetInt64(row, 0));
+		if (task >= last_task) {
+			break;
+		}
+		ctid_tasks.push_back(task);
+	}
+	ctid_tasks.push_back(last_task);
+	bind_data.max_threads = MinValue<idx_t>(bind_data.max_threads, ctid_tasks.size());
+	bind_data.ctid_tasks = std::move(ctid_tasks);
+}
+
+void PostgresIndexScan::PlanIndexScans(ClientContext &context, LogicalOperator &op) {
+	for (auto &child : op.children) {
+		PlanIndexScans(context, *child);
+	}
+	if (op.type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &get = op.Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return;
+	}
+	PlanPointLookup(get);
+	if (Enabled(context)) {
+		PlanIndexScan(context, get);
+	}
+	if (BlockRangeSkippingEnabled(context)) {
+		PlanBlockRanges(context, get);
+	}
+}
+
+} // namespace duckdb
@@ -20,15 +20,20 @@ PostgresIndexSet::PostgresIndexSet(PostgresSchemaEntry &schema, unique_ptr<Postg
 
 string PostgresIndexSet::GetInitializeQuery(const vector<string> &schemas) {
 	string base_query = R"(
-SELECT pg_namespace.oid, tablename, indexname
-FROM pg_indexes
-JOIN pg_namespace ON (schemaname=nspname)
-${CONDITION}
+SELECT pg_namespace.oid, tbl.relname, idx.relname, pg_am.amname, pg_index.indisunique,
+       pg_index.indpred IS NOT NULL, pg_attribute.attname
+FROM pg_index
+JOIN pg_class idx ON (idx.oid=pg_index.indexrelid)
+JOIN pg_class tbl ON (tbl.oid=pg_index.indrelid)
+JOIN pg_namespace ON (pg_namespace.oid=tbl.relnamespace)
+JOIN pg_am ON (pg_am.oid=idx.relam)
+LEFT JOIN pg_attribute ON (pg_attribute.attrelid=tbl.oid AND pg_attribute.attnum=pg_index.indkey[0])
+WHERE tbl.relkind IN ('r', 'm', 'p') AND idx.relkind IN ('i', 'I') ${CONDITION}
 ORDER BY pg_namespace.oid;
 )";
 	string condition;
 	if (schemas.size() > 0) {
-		condition += "WHERE pg_namespace.nspname IN (" + PostgresUtils::WriteLiteralsCommaSeparated(schemas) + ")";
+		condition += "AND pg_namespace.nspname IN (" + PostgresUtils::WriteLiteralsCommaSeparated(schemas) + ")";
 	}
 	return StringUtil::Replace(base_query, "${CONDITION}", condition);
 }
@@ -48,6 +53,12 @@ void PostgresIndexSet::LoadEntries(ClientContext &context, PostgresTransaction &
 		info.table = Identifier(table_name);
 		info.SetIndexName(Identifier(index_name));
 		auto index_entry = make_shared_ptr<PostgresIndexEntry>(catalog, schema, info, table_name);
+		index_entry->access_method = result.GetString(row, 3);
+		index_entry->is_unique = result.GetBool(row, 4);
+		index_entry->is_partial = result.GetBool(row, 5);
+		if (!result.IsNull(row, 6)) {
+			index_entry->leading_column = result.GetString(row, 6);
+		}
 		CreateEntry(transaction, std::move(index_entry));
 	}
 	index_result.reset();
@@ -91,6 +102,13 @@ optional_ptr<CatalogEntry> PostgresIndexSet::CreateIndex(PostgresTransaction &tr
 	transaction.Query(PGGetCreateIndexSQL(info, table));
 	auto index_entry =
 	    make_shared_ptr<PostgresIndexEntry>(schema.ParentCatalog(), schema, info, table.name.GetIdentifierName());
+	// CREATE INDEX without USING creates a btree index
+	index_entry->access_method = "btree";
+	index_entry->is_unique = info.constraint_type == IndexConstraintType::UNIQUE;
+	if (!info.parsed_expressions.empty() &&
+	    info.parsed_expressions[0]->GetExpressionType() == ExpressionType::COLUMN_REF) {
+		index_entry->leading_column = info.parsed_expressions[0]->Cast<ColumnRefExpression>().GetColumnName();
+	}
 	return CreateEntry(transaction, std::move(index_entry));
 }
 
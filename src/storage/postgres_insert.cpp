@@ -2,6 +2,9 @@
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/serializer/memory_stream.hpp"
+#include "duckdb/common/types/uuid.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
 #include "duckdb/planner/logical_operator.hpp"
 #include "storage/postgres_catalog.hpp"
@@ -15,6 +18,7 @@
 #include "duckdb/planner/expression/bound_cast_expression.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "postgres_connection.hpp"
+#include "postgres_oauth.hpp"
 #include "postgres_scanner.hpp"
 
 namespace duckdb {
@@ -23,18 +27,27 @@ PostgresInsert::PostgresInsert(PhysicalPlan &physical_plan, PostgresCatalog &pg_
                                LogicalOperator &op, TableCatalogEntry &table,
                                physical_index_vector_t<idx_t> column_index_map_p)
     : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, op.types, 1), table(&table), schema(nullptr),
-      column_index_map(std::move(column_index_map_p)), use_plain_inserts(UsePlainInserts(pg_catalog, context)) {
+      column_index_map(std::move(column_index_map_p)), use_plain_inserts(UsePlainInserts(pg_catalog, context)),
+      parallel_mode(GetParallelInsertMode(pg_catalog, context)), parallel_encoding(ParallelEncodingEnabled(context)) {
 }
 
 PostgresInsert::PostgresInsert(PhysicalPlan &physical_plan, PostgresCatalog &pg_catalog, ClientContext &context,
                                LogicalOperator &op, SchemaCatalogEntry &schema, unique_ptr<BoundCreateTableInfo> info)
     : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, op.types, 1), table(nullptr), schema(&schema),
-      info(std::move(info)), use_plain_inserts(UsePlainInserts(pg_catalog, context)) {
+      info(std::move(info)), use_plain_inserts(UsePlainInserts(pg_catalog, context)),
+      parallel_encoding(ParallelEncodingEnabled(context)),
+      bulk_load(GetBulkLoadMode(pg_catalog, context, *this->info)) {
 }
 
 //===--------------------------------------------------------------------===//
 // States
 //===--------------------------------------------------------------------===//
+//! The encoded rows of a finished batch of the source
+struct PostgresEncodedBatch {
+	unique_ptr<MemoryStream> data;
+	idx_t count = 0;
+};
+
 class PostgresInsertCopyGlobalState : public GlobalSinkState {
 public:
 	explicit PostgresInsertCopyGlobalState(ClientContext &context, PostgresTableEntry &table, PostgresCopyFormat format)
@@ -42,12 +55,40 @@ public:
 	}
 
 	PostgresTableEntry &table;
+	//! The COPY of the transaction
 	PostgresCopyState copy_state;
 	DataChunk varchar_chunk;
 	idx_t insert_count;
 	PostgresCopyFormat format;
 	vector<string> insert_column_names;
 	bool copy_is_active = false;
+	mutex lock;
+	PostgresParallelInsertMode parallel_mode = PostgresParallelInsertMode::DISABLED;
+	//! Whether the threads that share the COPY of the transaction encode their chunks before taking the lock
+	bool encode_locally = false;
+	//! Whether a thread is already writing to the COPY of the transaction
+	bool used_main_thread = false;
+	//! The staging tables of the threads with their own connection that are merged into the table (ATOMIC mode)
+	vector<string> staging_tables;
+	//! How the table is loaded - only set for a table that is created by the insert
+	PostgresBulkLoadMode bulk_load = PostgresBulkLoadMode::DISABLED;
+	//! Whether the encoded rows are sent in batch index order
+	bool send_in_batch_order = false;
+	//! Encoded batches that cannot be sent yet because a batch with a lower index is still being encoded
+	map<idx_t, PostgresEncodedBatch> pending_batches;
+
+	void BeginCopyTo(ClientContext &context, PostgresConnection &connection) {
+		if (copy_is_active) {
+			return;
+		}
+		// COPY ... FREEZE fails if the transaction has registered snapshots besides its own, e.g. when a parallel scan
+		// exported its snapshot - the rows are copied without FREEZE in that case
+		auto freeze = bulk_load != PostgresBulkLoadMode::DISABLED &&
+		              !PostgresTransaction::Get(context, table.catalog).HasExportedSnapshot();
+		connection.BeginCopyTo(context, copy_state, format, table.schema.name.GetIdentifierName(),
+		                       table.name.GetIdentifierName(), insert_column_names, freeze);
+		copy_is_active = true;
+	}
 
 	void FinishCopyTo(PostgresConnection &connection) {
 		if (!copy_is_active) {
@@ -58,6 +99,33 @@ public:
 	}
 };
 
+class PostgresInsertCopyLocalState : public LocalSinkState {
+public:
+	~PostgresInsertCopyLocalState() override {
+		if (copy_is_active) {
+			// the insert failed - end the COPY so the table it copies into is no longer locked by the connection
+			pool_connection.GetConnection().AbortCopyTo();
+		}
+	}
+
+	//! Whether the connection the thread writes to has been determined
+	bool initialized = false;
+	//! Whether the thread copies on its own connection of the pool - otherwise it writes to the COPY of the transaction
+	bool has_own_connection = false;
+	PostgresPoolConnection pool_connection;
+	//! The table the own connection copies into - a staging table in ATOMIC mode
+	string copy_table_name;
+	PostgresCopyState copy_state;
+	DataChunk varchar_chunk;
+	idx_t insert_count = 0;
+	bool copy_is_active = false;
+	//! Encoded rows that have not been sent over the COPY of the transaction yet
+	MemoryStream buffer;
+	idx_t buffered_count = 0;
+	//! The batch index of the buffered rows, if they are sent in batch index order
+	optional_idx current_batch;
+};
+
 class PostgresInsertPlainGlobalState : public GlobalSinkState {
 public:
 	explicit PostgresInsertPlainGlobalState(ClientContext &context, PostgresTableEntry &table,
@@ -99,6 +167,10 @@ static vector<string> GetInsertColumns(const PostgresInsert &insert, PostgresTab
 	return column_names;
 }
 
+static string GetQualifiedName(const string &schema_name, const string &table_name) {
+	return PostgresUtils::WriteIdentifier(schema_name) + "." + PostgresUtils::WriteIdentifier(table_name);
+}
+
 unique_ptr<GlobalSinkState> PostgresInsert::GetGlobalSinkStateCopy(ClientContext &context) const {
 	optional_ptr<PostgresTableEntry> insert_table;
 	if (!table) {
@@ -113,6 +185,16 @@ unique_ptr<GlobalSinkState> PostgresInsert::GetGlobalSinkStateCopy(ClientContext
 	auto insert_columns = GetInsertColumns(*this, *insert_table);
 	auto format = insert_table->GetCopyFormat(context);
 	auto result = make_uniq<PostgresInsertCopyGlobalState>(context, *insert_table, format);
+	result->parallel_mode = ParallelSink() ? parallel_mode : PostgresParallelInsertMode::DISABLED;
+	result->encode_locally = ParallelSink();
+	result->send_in_batch_order = RequiresBatchIndex();
+	result->bulk_load = bulk_load;
+	if (bulk_load == PostgresBulkLoadMode::UNLOGGED) {
+		// the table was just created and is still empty - so this does not rewrite any rows
+		auto table_name =
+		    GetQualifiedName(insert_table->schema.name.GetIdentifierName(), insert_table->name.GetIdentifierName());
+		connection.Execute(context, "ALTER TABLE " + table_name + " SET UNLOGGED");
+	}
 	auto &insert_column_names = result->insert_column_names;
 	if (!insert_columns.empty()) {
 		for (auto &str : insert_columns) {
@@ -128,6 +210,24 @@ unique_ptr<GlobalSinkState> PostgresInsert::GetGlobalSinkStateCopy(ClientContext
 	return std::move(result);
 }
 
+unique_ptr<LocalSinkState> PostgresInsert::GetLocalSinkStateCopy(ExecutionContext &context) const {
+	return make_uniq<PostgresInsertCopyLocalState>();
+}
+
+static string GetColumnList(const vector<string> &column_names) {
+	if (column_names.empty()) {
+		return "*";
+	}
+	string result;
+	for (auto &column_name : column_names) {
+		if (!result.empty()) {
+			result += ", ";
+		}
+		result += PostgresUtils::WriteIdentifier(column_name);
+	}
+	return result;
+}
+
 static string GetBaseInsertQuery(const PostgresTableEntry &table, const vector<string> &column_names) {
 	string query;
 	query += "INSERT INTO ";
@@ -173,17 +273,172 @@ unique_ptr<GlobalSinkState> PostgresInsert::GetGlobalSinkStatePlain(ClientContex
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
+//! Acquire a connection of the pool for a thread of a parallel insert and prepare the table it copies into
+static bool TryOpenInsertConnection(ClientContext &context, PostgresInsertCopyGlobalState &gstate,
+                                    PostgresInsertCopyLocalState &lstate) {
+	auto &pg_catalog = gstate.table.catalog.Cast<PostgresCatalog>();
+	{
+		auto oauth_token_holder = SetThreadLocalOAuthTokenFromSessionOption(context);
+		if (!pg_catalog.GetConnectionPool().TryGetConnection(lstate.pool_connection)) {
+			return false;
+		}
+	}
+	auto &schema_name = gstate.table.schema.name.GetIdentifierName();
+	auto table_name = GetQualifiedName(schema_name, gstate.table.name.GetIdentifierName());
+	// the table is locked with NOWAIT: if the transaction holds a conflicting lock on the table (e.g. after an ALTER
+	// TABLE) waiting for it would never finish, as the transaction cannot end before the insert does
+	string query = "BEGIN;";
+	if (gstate.parallel_mode == PostgresParallelInsertMode::ATOMIC) {
+		// the staging table is committed so the transaction can read it - it is dropped by the transaction
+		lstate.copy_table_name = "__duckdb_insert_" + UUID::ToString(UUID::GenerateRandomUUID());
+		query += "LOCK TABLE " + table_name + " IN ACCESS SHARE MODE NOWAIT;";
+		query += "CREATE UNLOGGED TABLE " + GetQualifiedName(schema_name, lstate.copy_table_name) + " AS SELECT " +
+		         GetColumnList(gstate.insert_column_names) + " FROM " + table_name + " WITH NO DATA;";
+	} else {
+		lstate.copy_table_name = gstate.table.name.GetIdentifierName();
+		query += "LOCK TABLE " + table_name + " IN ROW EXCLUSIVE MODE NOWAIT;";
+	}
+	query += "COMMIT";
+	auto &connection = lstate.pool_connection.GetConnection();
+	if (!connection.TryQuery(context, query)) {
+		// e.g. the table was created in the transaction and is not visible to other connections yet, or it is locked
+		// by the transaction - the transaction block of the failed query is still open
+		connection.TryQuery(context, "ROLLBACK");
+		lstate.pool_connection = PostgresPoolConnection();
+		return false;
+	}
+	if (gstate.parallel_mode == PostgresParallelInsertMode::ATOMIC) {
+		auto &transaction = PostgresTransaction::Get(context, gstate.table.catalog);
+		transaction.DropOnRollback(GetQualifiedName(schema_name, lstate.copy_table_name));
+	}
+	return true;
+}
+
+static void InitializeLocalCopy(ClientContext &context, PostgresInsertCopyGlobalState &gstate,
+                                PostgresInsertCopyLocalState &lstate) {
+	lstate.initialized = true;
+	if (gstate.encode_locally) {
+		lstate.copy_state.Initialize(context);
+		lstate.copy_state.format = gstate.format;
+	}
+	if (gstate.parallel_mode == PostgresParallelInsertMode::DISABLED) {
+		return;
+	}
+	{
+		lock_guard<mutex> guard(gstate.lock);
+		if (!gstate.used_main_thread) {
+			// the first thread writes to the COPY of the transaction
+			gstate.used_main_thread = true;
+			return;
+		}
+	}
+	// if the pool is exhausted the thread shares the COPY of the transaction
+	lstate.has_own_connection = TryOpenInsertConnection(context, gstate, lstate);
+}
+
+//! Send encoded rows over the COPY of the transaction - the lock of the global state must be held
+static void SendCopyData(ClientContext &context, PostgresInsertCopyGlobalState &gstate, MemoryStream &data,
+                         idx_t count) {
+	auto &transaction = PostgresTransaction::Get(context, gstate.table.catalog);
+	auto &connection = transaction.GetConnection();
+	gstate.BeginCopyTo(context, connection);
+	connection.CopyData(data.GetData(), data.GetPosition());
+	gstate.insert_count += count;
+}
+
+//! Send the finished batches with an index below min_batch_index in order - no batch before them can still arrive
+static void SendPendingBatches(ClientContext &context, PostgresInsertCopyGlobalState &gstate, idx_t min_batch_index) {
+	while (!gstate.pending_batches.empty() && gstate.pending_batches.begin()->first < min_batch_index) {
+		auto &batch = gstate.pending_batches.begin()->second;
+		SendCopyData(context, gstate, *batch.data, batch.count);
+		gstate.pending_batches.erase(gstate.pending_batches.begin());
+	}
+}
+
+//! Send the rows a thread has encoded over the COPY of the transaction
+static void FlushCopyBuffer(ClientContext &context, PostgresInsertCopyGlobalState &gstate,
+                            PostgresInsertCopyLocalState &lstate) {
+	if (lstate.buffered_count == 0) {
+		return;
+	}
+	lock_guard<mutex> guard(gstate.lock);
+	SendCopyData(context, gstate, lstate.buffer, lstate.buffered_count);
+	lstate.buffer.Rewind();
+	lstate.buffered_count = 0;
+}
+
+//! Hand the encoded rows of a finished batch to the global state, which sends them once all earlier batches are sent
+static void FinishBatch(ClientContext &context, PostgresInsertCopyGlobalState &gstate,
+                        PostgresInsertCopyLocalState &lstate, idx_t min_batch_index) {
+	if (!lstate.current_batch.IsValid()) {
+		return;
+	}
+	auto batch_index = lstate.current_batch.GetIndex();
+	lstate.current_batch = optional_idx();
+	lock_guard<mutex> guard(gstate.lock);
+	if (lstate.buffered_count > 0) {
+		PostgresEncodedBatch batch;
+		batch.data = make_uniq<MemoryStream>(lstate.buffer.GetPosition());
+		batch.data->WriteData(lstate.buffer.GetData(), lstate.buffer.GetPosition());
+		batch.count = lstate.buffered_count;
+		gstate.pending_batches[batch_index] = std::move(batch);
+		lstate.buffer.Rewind();
+		lstate.buffered_count = 0;
+	}
+	SendPendingBatches(context, gstate, min_batch_index);
+}
+
 SinkResultType PostgresInsert::SinkCopy(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
+	static constexpr const idx_t COPY_BUFFER_SIZE = 1048576;
+
 	auto &gstate = input.global_state.Cast<PostgresInsertCopyGlobalState>();
+	auto &lstate = input.local_state.Cast<PostgresInsertCopyLocalState>();
+	if (!lstate.initialized) {
+		InitializeLocalCopy(context.client, gstate, lstate);
+	}
+	if (lstate.has_own_connection) {
+		auto &connection = lstate.pool_connection.GetConnection();
+		if (!lstate.copy_is_active) {
+			connection.BeginCopyTo(context.client, lstate.copy_state, gstate.format,
+			                       gstate.table.schema.name.GetIdentifierName(), lstate.copy_table_name,
+			                       gstate.insert_column_names);
+			lstate.copy_is_active = true;
+		}
+		connection.CopyChunk(context.client, lstate.copy_state, chunk, lstate.varchar_chunk);
+		lstate.insert_count += chunk.size();
+		return SinkResultType::NEED_MORE_INPUT;
+	}
+	if (gstate.encode_locally) {
+		// encode the chunk in this thread - only sending the encoded rows over the connection of the transaction is
+		// serialized
+		if (gstate.send_in_batch_order && !lstate.current_batch.IsValid()) {
+			lstate.current_batch = lstate.partition_info.batch_index.GetIndex();
+		}
+		PostgresConnection::EncodeChunk(context.client, lstate.copy_state, chunk, lstate.varchar_chunk, lstate.buffer);
+		lstate.buffered_count += chunk.size();
+		if (lstate.buffer.GetPosition() < COPY_BUFFER_SIZE) {
+			return SinkResultType::NEED_MORE_INPUT;
+		}
+		if (!gstate.send_in_batch_order) {
+			FlushCopyBuffer(context.client, gstate, lstate);
+			return SinkResultType::NEED_MORE_INPUT;
+		}
+		auto batch_index = lstate.current_batch.GetIndex();
+		if (batch_index <= lstate.partition_info.min_batch_index.GetIndex()) {
+			// no other thread is encoding an earlier batch - send the earlier batches and then stream this one
+			{
+				lock_guard<mutex> guard(gstate.lock);
+				SendPendingBatches(context.client, gstate, batch_index);
+			}
+			FlushCopyBuffer(context.client, gstate, lstate);
+		}
+		// otherwise the rows are kept until the batch is finished and all earlier batches have been sent
+		return SinkResultType::NEED_MORE_INPUT;
+	}
+	lock_guard<mutex> guard(gstate.lock);
 	auto &transaction = PostgresTransaction::Get(context.client, gstate.table.catalog);
 	auto &connection = transaction.GetConnection();
-	if (!gstate.copy_is_active) {
-		// copy hasn't started yet
-		connection.BeginCopyTo(context.client, gstate.copy_state, gstate.format,
-		                       gstate.table.schema.name.GetIdentifierName(), gstate.table.name.GetIdentifierName(),
-		                       gstate.insert_column_names);
-		gstate.copy_is_active = true;
-	}
+	gstate.BeginCopyTo(context.client, connection);
 	connection.CopyChunk(context.client, gstate.copy_state, chunk, gstate.varchar_chunk);
 	gstate.insert_count += chunk.size();
 	if (!keep_copy_alive) {
@@ -313,6 +568,46 @@ SinkResultType PostgresInsert::SinkPlain(ExecutionContext &context, DataChunk &c
 	return SinkResultType::NEED_MORE_INPUT;
 }
 
+//===--------------------------------------------------------------------===//
+// Next Batch
+//===--------------------------------------------------------------------===//
+SinkNextBatchType PostgresInsert::NextBatchCopy(ExecutionContext &context, OperatorSinkNextBatchInput &input) const {
+	auto &gstate = input.global_state.Cast<PostgresInsertCopyGlobalState>();
+	auto &lstate = input.local_state.Cast<PostgresInsertCopyLocalState>();
+	if (gstate.send_in_batch_order) {
+		FinishBatch(context.client, gstate, lstate, lstate.partition_info.min_batch_index.GetIndex());
+	}
+	return SinkNextBatchType::READY;
+}
+
+//===--------------------------------------------------------------------===//
+// Combine
+//===--------------------------------------------------------------------===//
+SinkCombineResultType PostgresInsert::CombineCopy(ExecutionContext &context, OperatorSinkCombineInput &input) const {
+	auto &gstate = input.global_state.Cast<PostgresInsertCopyGlobalState>();
+	auto &lstate = input.local_state.Cast<PostgresInsertCopyLocalState>();
+	if (!lstate.has_own_connection) {
+		if (gstate.send_in_batch_order) {
+			// the remaining batches are sent in order when the insert is finalized
+			FinishBatch(context.client, gstate, lstate, lstate.partition_info.min_batch_index.GetIndex());
+		} else {
+			FlushCopyBuffer(context.client, gstate, lstate);
+		}
+		return SinkCombineResultType::FINISHED;
+	}
+	if (lstate.copy_is_active) {
+		// the connection is not in a transaction - this commits the rows of the thread
+		lstate.pool_connection.GetConnection().FinishCopyTo(lstate.copy_state);
+		lstate.copy_is_active = false;
+	}
+	lock_guard<mutex> guard(gstate.lock);
+	gstate.insert_count += lstate.insert_count;
+	if (gstate.parallel_mode == PostgresParallelInsertMode::ATOMIC) {
+		gstate.staging_tables.push_back(lstate.copy_table_name);
+	}
+	return SinkCombineResultType::FINISHED;
+}
+
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
@@ -321,12 +616,44 @@ SinkFinalizeType PostgresInsert::FinalizeCopy(Pipeline &pipeline, Event &event,
 	auto &gstate = input.global_state.Cast<PostgresInsertCopyGlobalState>();
 	auto &transaction = PostgresTransaction::Get(context, gstate.table.catalog);
 	auto &connection = transaction.GetConnection();
+	SendPendingBatches(context, gstate, NumericLimits<idx_t>::Maximum());
 	gstate.FinishCopyTo(connection);
+	if (!gstate.staging_tables.empty()) {
+		// merge the rows that were copied on other connections into the table within the transaction
+		auto &schema_name = gstate.table.schema.name.GetIdentifierName();
+		auto column_list = GetColumnList(gstate.insert_column_names);
+		auto insert_query = "INSERT INTO " + GetQualifiedName(schema_name, gstate.table.name.GetIdentifierName());
+		if (!gstate.insert_column_names.empty()) {
+			insert_query += " (" + column_list + ")";
+		}
+		string query;
+		for (auto &staging_table : gstate.staging_tables) {
+			auto staging_name = GetQualifiedName(schema_name, staging_table);
+			query += insert_query + " SELECT " + column_list + " FROM " + staging_name + ";";
+			query += "DROP TABLE " + staging_name + ";";
+		}
+		connection.Execute(context, query);
+		gstate.staging_tables.clear();
+	}
+	if (gstate.bulk_load != PostgresBulkLoadMode::DISABLED) {
+		auto table_name =
+		    GetQualifiedName(gstate.table.schema.name.GetIdentifierName(), gstate.table.name.GetIdentifierName());
+		string query;
+		if (gstate.bulk_load == PostgresBulkLoadMode::UNLOGGED) {
+			query += "ALTER TABLE " + table_name + " SET LOGGED;";
+		}
+		// collect the statistics of the new table now instead of waiting for autovacuum
+		query += "ANALYZE " + table_name + ";";
+		connection.Execute(context, query);
+	}
 	// update the approx_num_pages - approximately 8 bytes per column per row
 	idx_t bytes_per_page = 8192;
 	idx_t bytes_per_row = gstate.table.GetColumns().LogicalColumnCount() * 8;
 	idx_t rows_per_page = MaxValue<idx_t>(1, bytes_per_page / bytes_per_row);
 	gstate.table.approx_num_pages.fetch_add(gstate.insert_count / rows_per_page, std::memory_order_acq_rel);
+	if (gstate.table.approx_num_rows.load(std::memory_order_acquire) >= 0) {
+		gstate.table.approx_num_rows.fetch_add(NumericCast<int64_t>(gstate.insert_count), std::memory_order_acq_rel);
+	}
 	return SinkFinalizeType::READY;
 }
 
@@ -374,6 +701,74 @@ InsertionOrderPreservingMap<string> PostgresInsert::ParamsToString() const {
 	return result;
 }
 
+PostgresParallelInsertMode PostgresInsert::GetParallelInsertMode(PostgresCatalog &pg_catalog, ClientContext &context) {
+	Value value;
+	if (!context.TryGetCurrentSetting("pg_parallel_insert", value) || value.IsNull()) {
+		return PostgresParallelInsertMode::DISABLED;
+	}
+	auto mode = StringUtil::Lower(StringValue::Get(value));
+	if (mode == "atomic") {
+		// the staging tables are committed after the transaction has taken its snapshot - only a transaction that
+		// takes a new snapshot for every statement sees their rows when merging them into the table
+		if (pg_catalog.isolation_level != PostgresIsolationLevel::READ_COMMITTED) {
+			return PostgresParallelInsertMode::DISABLED;
+		}
+		return PostgresParallelInsertMode::ATOMIC;
+	}
+	if (mode == "non_atomic") {
+		return PostgresParallelInsertMode::NON_ATOMIC;
+	}
+	return PostgresParallelInsertMode::DISABLED;
+}
+
+void PostgresInsert::PlanParallelEncoding(ClientContext &context, PhysicalOperator &plan) {
+	// with pg_parallel_insert the threads with their own connection commit their rows independently - the order of
+	// the rows is not preserved in that case
+	if (!parallel_encoding || parallel_mode != PostgresParallelInsertMode::DISABLED ||
+	    !PhysicalPlanGenerator::PreserveInsertionOrder(context, plan)) {
+		return;
+	}
+	if (PhysicalPlanGenerator::UseBatchIndex(context, plan)) {
+		send_in_batch_order = true;
+	} else {
+		// the rows cannot be put back in order - encode them on the thread that sends them
+		parallel_encoding = false;
+	}
+}
+
+bool PostgresInsert::ParallelEncodingEnabled(ClientContext &context) {
+	Value value;
+	if (context.TryGetCurrentSetting("pg_parallel_copy_encoding", value) && !value.IsNull()) {
+		return BooleanValue::Get(value);
+	}
+	return false;
+}
+
+PostgresBulkLoadMode PostgresInsert::GetBulkLoadMode(PostgresCatalog &pg_catalog, ClientContext &context,
+                                                     const BoundCreateTableInfo &info) {
+	Value value;
+	if (!context.TryGetCurrentSetting("pg_bulk_load", value) || value.IsNull()) {
+		return PostgresBulkLoadMode::DISABLED;
+	}
+	auto mode = StringUtil::Lower(StringValue::Get(value));
+	if (mode == "disabled") {
+		return PostgresBulkLoadMode::DISABLED;
+	}
+	// with IF NOT EXISTS the rows might be copied into an existing table, which cannot be frozen
+	if (info.Base().on_conflict == OnCreateConflict::IGNORE_ON_CONFLICT) {
+		return PostgresBulkLoadMode::DISABLED;
+	}
+	auto version = pg_catalog.GetPostgresVersion();
+	if (version.type_v == PostgresInstanceType::REDSHIFT) {
+		return PostgresBulkLoadMode::DISABLED;
+	}
+	// SET LOGGED was introduced in Postgres 9.5
+	if (mode == "unlogged" && version >= PostgresVersion(9, 5)) {
+		return PostgresBulkLoadMode::UNLOGGED;
+	}
+	return PostgresBulkLoadMode::FREEZE;
+}
+
 bool PostgresInsert::UsePlainInserts(PostgresCatalog &pg_catalog, ClientContext &context) {
 	bool use_text_proto_user_option = false;
 	Value value;
@@ -459,6 +854,7 @@ PhysicalOperator &PostgresCatalog::PlanInsert(ClientContext &context, PhysicalPl
 	auto &inner_plan = AddCastToPostgresTypes(context, planner, *plan);
 
 	auto &insert = planner.Make<PostgresInsert>(*this, context, op, op.table, op.column_index_map);
+	insert.PlanParallelEncoding(context, inner_plan);
 	insert.children.push_back(inner_plan);
 	return insert;
 }
@@ -469,6 +865,7 @@ PhysicalOperator &PostgresCatalog::PlanCreateTableAs(ClientContext &context, Phy
 	MaterializePostgresScans(inner_plan);
 
 	auto &insert = planner.Make<PostgresInsert>(*this, context, op, op.schema, std::move(op.info));
+	insert.PlanParallelEncoding(context, inner_plan);
 	insert.children.push_back(inner_plan);
 	return insert;
 }
@@ -0,0 +1,278 @@
+#include "storage/postgres_join_pushdown.hpp"
+
+#include "duckdb/optimizer/column_binding_replacer.hpp"
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/operator/logical_comparison_join.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+#include "postgres_expression_pushdown.hpp"
+#include "postgres_filter_pushdown.hpp"
+#include "postgres_scanner.hpp"
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_explain.hpp"
+
+namespace duckdb {
+
+struct PostgresJoinSide {
+	PostgresJoinSide(LogicalGet &get, PostgresBindData &bind_data, string prefix)
+	    : get(get), bind_data(bind_data), prefix(std::move(prefix)) {
+	}
+
+	LogicalGet &get;
+	PostgresBindData &bind_data;
+	//! Prefix of the column aliases of this side
+	string prefix;
+	//! The FROM and WHERE clause of this side
+	string source;
+	//! Aliases of the columns of the scan, in the order of the column ids
+	vector<string> column_aliases;
+	//! The select list of the columns of the scan
+	vector<string> select_list;
+	//! The select list of the join keys
+	vector<string> key_list;
+
+	string ColumnQuery() const {
+		return "SELECT " + (select_list.empty() ? "NULL" : StringUtil::Join(select_list, ", ")) + source;
+	}
+	string JoinQuery() const {
+		auto columns = select_list;
+		columns.insert(columns.end(), key_list.begin(), key_list.end());
+		return "(SELECT " + StringUtil::Join(columns, ", ") + source + ")";
+	}
+};
+
+static optional_ptr<PostgresBindData> GetJoinScan(LogicalOperator &op) {
+	if (op.type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = op.Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return nullptr;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!bind_data.GetCatalog() || bind_data.command_only || bind_data.emit_ctid || !bind_data.params.Empty()) {
+		return nullptr;
+	}
+	if (bind_data.table_name.empty() && !bind_data.remote_join) {
+		// arbitrary postgres_query statements cannot be used as a sub-query
+		return nullptr;
+	}
+	if (!bind_data.order_by_and_limit_bind_data.order_by_clause.empty() ||
+	    !bind_data.order_by_and_limit_bind_data.limit_clause.empty() || bind_data.distinct) {
+		return nullptr;
+	}
+	for (auto &column_index : get.GetColumnIds()) {
+		if (IsVirtualColumn(column_index.GetPrimaryIndex())) {
+			return nullptr;
+		}
+	}
+	return &bind_data;
+}
+
+static void InitializeSide(PostgresJoinSide &side) {
+	auto &bind_data = side.bind_data;
+	auto &column_ids = side.get.GetColumnIds();
+	vector<column_t> filter_column_ids;
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		auto column_id = column_ids[i].GetPrimaryIndex();
+		filter_column_ids.push_back(column_id);
+
+		auto alias = side.prefix + to_string(i);
+		string column;
+		if (bind_data.skipped_columns.find(column_id) != bind_data.skipped_columns.end()) {
+			column = "NULL";
+		} else if (bind_data.IsRemoteExpression(column_id)) {
+			column = bind_data.remote_expressions[column_id];
+		} else {
+			column = PostgresUtils::WriteIdentifier(bind_data.names[column_id]);
+		}
+		side.select_list.push_back(column + " AS " + PostgresUtils::WriteIdentifier(alias));
+		side.column_aliases.push_back(std::move(alias));
+	}
+	if (bind_data.table_name.empty()) {
+		side.source = " FROM (" + bind_data.sql + ") AS __pg_source";
+	} else {
+		side.source = " FROM " + PostgresUtils::WriteIdentifier(bind_data.schema_name) + "." +
+		              PostgresUtils::WriteIdentifier(bind_data.table_name) + bind_data.sample_clause;
+	}
+	auto filter = PostgresFilterPushdown::TransformFilters(filter_column_ids, &side.get.table_filters, bind_data.names);
+	for (auto &remote_filter : bind_data.remote_filters) {
+		if (!filter.empty()) {
+			filter += " AND ";
+		}
+		filter += remote_filter;
+	}
+	if (!filter.empty()) {
+		side.source += " WHERE " + filter;
+	}
+}
+
+static bool IsEqualityComparison(ExpressionType type) {
+	return type == ExpressionType::COMPARE_EQUAL || type == ExpressionType::COMPARE_NOT_DISTINCT_FROM;
+}
+
+static string TransformKey(Expression &expr, PostgresJoinSide &side, ExpressionType comparison) {
+	if (IsEqualityComparison(comparison) && expr.GetExpressionClass() == ExpressionClass::BOUND_COLUMN_REF) {
+		// equality of plain columns has the same semantics in Postgres for all non-nested types
+		auto &colref = expr.Cast<BoundColumnRefExpression>();
+		auto column_index = PostgresExpressionPushdown::GetColumnIndex(side.get, colref.binding.column_index);
+		if (colref.binding.table_index != side.get.table_index || column_index == DConstants::INVALID_INDEX) {
+			return string();
+		}
+		auto column_id = side.get.GetColumnIds()[column_index].GetPrimaryIndex();
+		if (side.bind_data.IsRemoteExpression(column_id) || expr.return_type.IsNested() ||
+		    side.bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+			return string();
+		}
+		return PostgresUtils::WriteIdentifier(side.bind_data.names[column_id]);
+	}
+	if (!IsEqualityComparison(comparison) && expr.return_type.id() == LogicalTypeId::VARCHAR) {
+		// string ordering depends on the collation of the Postgres column
+		return string();
+	}
+	return PostgresExpressionPushdown::TransformExpression(expr, side.get, side.bind_data);
+}
+
+static void AddOutputColumns(PostgresJoinSide &side, PostgresBindData &result, vector<LogicalType> &types) {
+	auto &column_ids = side.get.GetColumnIds();
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		auto column_id = column_ids[i].GetPrimaryIndex();
+		result.names.push_back(side.column_aliases[i]);
+		result.types.push_back(side.bind_data.types[column_id]);
+		result.postgres_types.push_back(side.bind_data.postgres_types[column_id]);
+		types.push_back(side.bind_data.types[column_id]);
+	}
+}
+
+static void AddReplacementBindings(PostgresJoinSide &side, TableIndex table_index, idx_t offset,
+                                   ColumnBindingReplacer &replacer) {
+	auto bindings = side.get.GetColumnBindings();
+	for (idx_t i = 0; i < bindings.size(); i++) {
+		auto column_index = PostgresExpressionPushdown::GetColumnIndex(side.get, i);
+		replacer.replacement_bindings.emplace_back(bindings[i], ColumnBinding(table_index, offset + column_index));
+	}
+}
+
+static bool TryPushdownJoin(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &op,
+                            ColumnBindingReplacer &replacer) {
+	if (op->type != LogicalOperatorType::LOGICAL_COMPARISON_JOIN) {
+		return false;
+	}
+	auto &join = op->Cast<LogicalComparisonJoin>();
+	if (join.join_type != JoinType::INNER && join.join_type != JoinType::LEFT) {
+		return false;
+	}
+	auto left_bind_data = GetJoinScan(*join.children[0]);
+	auto right_bind_data = GetJoinScan(*join.children[1]);
+	if (!left_bind_data || !right_bind_data || left_bind_data->GetCatalog().get() != right_bind_data->GetCatalog().get()) {
+		return false;
+	}
+	PostgresJoinSide left(join.children[0]->Cast<LogicalGet>(), *left_bind_data, "l");
+	PostgresJoinSide right(join.children[1]->Cast<LogicalGet>(), *right_bind_data, "r");
+	InitializeSide(left);
+	InitializeSide(right);
+
+	vector<string> conditions;
+	for (auto &condition : join.conditions) {
+		auto comparison = PostgresExpressionPushdown::GetComparisonOperator(condition.comparison);
+		if (comparison.empty()) {
+			return false;
+		}
+		auto left_key = TransformKey(*condition.left, left, condition.comparison);
+		auto right_key = TransformKey(*condition.right, right, condition.comparison);
+		if (left_key.empty() || right_key.empty()) {
+			return false;
+		}
+		auto key_index = to_string(conditions.size());
+		left.key_list.push_back(left_key + " AS " + PostgresUtils::WriteIdentifier("lk" + key_index));
+		right.key_list.push_back(right_key + " AS " + PostgresUtils::WriteIdentifier("rk" + key_index));
+		conditions.push_back(PostgresUtils::WriteIdentifier("lk" + key_index) + " " + comparison + " " +
+		                     PostgresUtils::WriteIdentifier("rk" + key_index));
+	}
+	if (conditions.empty()) {
+		return false;
+	}
+	vector<string> output_columns;
+	for (auto &alias : left.column_aliases) {
+		output_columns.push_back(PostgresUtils::WriteIdentifier(alias));
+	}
+	for (auto &alias : right.column_aliases) {
+		output_columns.push_back(PostgresUtils::WriteIdentifier(alias));
+	}
+	if (output_columns.empty()) {
+		// e.g. COUNT(*) over the join
+		output_columns.push_back("NULL");
+	}
+	auto join_sql = StringUtil::Format("SELECT %s FROM %s AS __pg_left %s %s AS __pg_right ON %s",
+	                                   StringUtil::Join(output_columns, ", "), left.JoinQuery(),
+	                                   join.join_type == JoinType::LEFT ? "LEFT JOIN" : "JOIN", right.JoinQuery(),
+	                                   StringUtil::Join(conditions, " AND "));
+
+	// only push the join if Postgres estimates this to be cheaper than transferring both sides and joining locally
+	auto &context = input.context;
+	auto &catalog = *left_bind_data->GetCatalog();
+	PostgresPlanEstimate join_estimate, left_estimate, right_estimate;
+	if (!PostgresExplain::TryGetEstimate(context, catalog, join_sql, join_estimate) ||
+	    !PostgresExplain::TryGetEstimate(context, catalog, left.ColumnQuery(), left_estimate) ||
+	    !PostgresExplain::TryGetEstimate(context, catalog, right.ColumnQuery(), right_estimate)) {
+		return false;
+	}
+	if (PostgresExplain::EstimateTransferCost(join_estimate) >=
+	    PostgresExplain::EstimateTransferCost(left_estimate) + PostgresExplain::EstimateTransferCost(right_estimate)) {
+		return false;
+	}
+
+	auto result = make_uniq<PostgresBindData>(context);
+	result->SetCatalog(catalog);
+	result->dsn = left_bind_data->dsn;
+	result->attach_path = left_bind_data->attach_path;
+	result->sql = std::move(join_sql);
+	result->read_only = false;
+	result->remote_join = true;
+	vector<LogicalType> returned_types;
+	AddOutputColumns(left, *result, returned_types);
+	AddOutputColumns(right, *result, returned_types);
+	decltype(left.get.names) returned_names;
+	for (auto &name : result->names) {
+		returned_names.emplace_back(name);
+	}
+	PostgresScanFunction::PrepareBind(catalog.GetPostgresVersion(), context, *result, 0);
+
+	auto table_index = input.optimizer.binder.GenerateTableIndex();
+	AddReplacementBindings(left, table_index, 0, replacer);
+	AddReplacementBindings(right, table_index, left.column_aliases.size(), replacer);
+
+	auto get = make_uniq<LogicalGet>(table_index, PostgresQueryFunction(), std::move(result), std::move(returned_types),
+	                                 std::move(returned_names));
+	for (idx_t i = 0; i < get->returned_types.size(); i++) {
+		get->AddColumnId(i);
+	}
+	get->SetEstimatedCardinality(static_cast<idx_t>(join_estimate.plan_rows));
+	op = std::move(get);
+	return true;
+}
+
+static void PushdownJoins(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &op,
+                          unique_ptr<LogicalOperator> &plan) {
+	for (auto &child : op->children) {
+		PushdownJoins(input, child, plan);
+	}
+	ColumnBindingReplacer replacer;
+	if (TryPushdownJoin(input, op, replacer)) {
+		// point all references to the columns of the joined scans to the new scan
+		replacer.VisitOperator(*plan);
+	}
+}
+
+void PostgresJoinPushdown::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	Value pushdown;
+	if (!input.context.TryGetCurrentSetting("pg_experimental_join_pushdown", pushdown) ||
+	    !BooleanValue::Get(pushdown)) {
+		return;
+	}
+	PushdownJoins(input, plan, plan);
+}
+
+} // namespace duckdb
@@ -0,0 +1,364 @@
+#include "storage/postgres_late_materialization.hpp"
+
+#include "duckdb/optimizer/column_binding_replacer.hpp"
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+#include "postgres_binary_reader.hpp"
+#include "postgres_expression_pushdown.hpp"
+#include "postgres_scanner.hpp"
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_transaction.hpp"
+
+namespace duckdb {
+
+struct PostgresFetchByCtidData : public TableFunctionData {
+	//! Describes the columns of the table - used to read the fetched rows
+	unique_ptr<PostgresBindData> table_data;
+	//! The columns that are fetched - the ctid followed by the late columns
+	vector<column_t> fetch_column_ids;
+	//! The SELECT statement that fetches the columns, without the WHERE clause
+	string select_sql;
+	//! The input column that holds the ctid
+	idx_t ctid_index;
+	//! For every output column, the input column that is passed through or INVALID_INDEX for a fetched column
+	vector<idx_t> input_columns;
+	//! For every fetched output column, its index in the fetched rows
+	vector<idx_t> fetch_columns;
+};
+
+struct PostgresFetchByCtidGlobalState : public GlobalTableFunctionState {
+	//! The rows are fetched over the connection of the transaction, which is not thread-safe
+	mutex lock;
+};
+
+struct PostgresFetchByCtidLocalState : public LocalTableFunctionState {
+	//! The input rows that are waiting to be fetched
+	DataChunk buffer;
+	//! The amount of rows of the current input that have been added to the buffer
+	idx_t input_offset = 0;
+	DataChunk fetched;
+};
+
+static unique_ptr<GlobalTableFunctionState> PostgresFetchByCtidInitGlobal(ClientContext &context,
+                                                                          TableFunctionInitInput &input) {
+	return make_uniq<PostgresFetchByCtidGlobalState>();
+}
+
+static unique_ptr<LocalTableFunctionState> PostgresFetchByCtidInitLocal(ExecutionContext &context,
+                                                                        TableFunctionInitInput &input,
+                                                                        GlobalTableFunctionState *global_state) {
+	auto &data = input.bind_data->Cast<PostgresFetchByCtidData>();
+	auto result = make_uniq<PostgresFetchByCtidLocalState>();
+	vector<LogicalType> fetched_types;
+	for (auto column_id : data.fetch_column_ids) {
+		fetched_types.push_back(column_id == COLUMN_IDENTIFIER_ROW_ID ? LogicalType::BIGINT
+		                                                              : data.table_data->types[column_id]);
+	}
+	result->fetched.Initialize(Allocator::Get(context.client), fetched_types);
+	return std::move(result);
+}
+
+static void PostgresFetchRows(ClientContext &context, const PostgresFetchByCtidData &data,
+                              PostgresFetchByCtidGlobalState &gstate, PostgresFetchByCtidLocalState &lstate,
+                              DataChunk &output) {
+	auto &buffer = lstate.buffer;
+	auto &fetched = lstate.fetched;
+	buffer.Flatten();
+	auto ctids = FlatVector::GetDataMutable<int64_t>(buffer.data[data.ctid_index]);
+	string tid_list;
+	for (idx_t i = 0; i < buffer.size(); i++) {
+		if (!tid_list.empty()) {
+			tid_list += ",";
+		}
+		// extract the ctid from the row id
+		tid_list += "\"(" + to_string(ctids[i] >> 16) + "," + to_string(ctids[i] & 0xFFFF) + ")\"";
+	}
+	auto query = StringUtil::Format(R"(COPY (%sWHERE ctid = ANY('{%s}'::tid[])) TO STDOUT (FORMAT "binary");)",
+	                                data.select_sql, tid_list);
+	fetched.Reset();
+	{
+		lock_guard<mutex> guard(gstate.lock);
+		auto &transaction = PostgresTransaction::Get(context, *data.table_data->GetCatalog());
+		PostgresBinaryReader reader(transaction.GetConnection(), data.fetch_column_ids, *data.table_data);
+		reader.BeginCopy(context, query);
+		DataChunk trailer;
+		auto result = reader.Read(fetched);
+		while (result == PostgresReadResult::HAVE_MORE_TUPLES) {
+			if (fetched.size() < STANDARD_VECTOR_SIZE) {
+				result = reader.Read(fetched);
+				continue;
+			}
+			// every ctid matches at most one row - only the end of the COPY remains
+			if (trailer.ColumnCount() == 0) {
+				trailer.Initialize(Allocator::Get(context), fetched.GetTypes());
+			}
+			trailer.Reset();
+			result = reader.Read(trailer);
+		}
+	}
+	// match the fetched rows with the buffered rows - rows that were deleted in the meantime are not returned
+	unordered_map<int64_t, idx_t> fetched_rows;
+	auto fetched_ctids = FlatVector::GetDataMutable<int64_t>(fetched.data[0]);
+	for (idx_t row = 0; row < fetched.size(); row++) {
+		fetched_rows[fetched_ctids[row]] = row;
+	}
+	SelectionVector input_sel(STANDARD_VECTOR_SIZE);
+	SelectionVector fetched_sel(STANDARD_VECTOR_SIZE);
+	idx_t count = 0;
+	for (idx_t i = 0; i < buffer.size(); i++) {
+		auto entry = fetched_rows.find(ctids[i]);
+		if (entry == fetched_rows.end()) {
+			continue;
+		}
+		input_sel.set_index(count, i);
+		fetched_sel.set_index(count, entry->second);
+		count++;
+	}
+	for (idx_t col = 0; col < output.ColumnCount(); col++) {
+		if (data.input_columns[col] != DConstants::INVALID_INDEX) {
+			output.data[col].Slice(buffer.data[data.input_columns[col]], input_sel, count);
+		} else {
+			output.data[col].Slice(fetched.data[data.fetch_columns[col]], fetched_sel, count);
+		}
+	}
+	output.SetChildCardinality(count);
+	buffer.Reset();
+}
+
+static OperatorResultType PostgresFetchByCtid(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
+                                              DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<PostgresFetchByCtidData>();
+	auto &gstate = data_p.global_state->Cast<PostgresFetchByCtidGlobalState>();
+	auto &lstate = data_p.local_state->Cast<PostgresFetchByCtidLocalState>();
+	if (lstate.buffer.ColumnCount() == 0) {
+		lstate.buffer.Initialize(Allocator::Get(context.client), input.GetTypes());
+	}
+	// collect rows until a full vector can be fetched with a single query
+	auto append_count =
+	    MinValue<idx_t>(input.size() - lstate.input_offset, STANDARD_VECTOR_SIZE - lstate.buffer.size());
+	SelectionVector sel(STANDARD_VECTOR_SIZE);
+	for (idx_t i = 0; i < append_count; i++) {
+		sel.set_index(i, lstate.input_offset + i);
+	}
+	lstate.buffer.Append(input, false, &sel, append_count);
+	lstate.input_offset += append_count;
+	if (lstate.buffer.size() < STANDARD_VECTOR_SIZE) {
+		lstate.input_offset = 0;
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
+	PostgresFetchRows(context.client, data, gstate, lstate, output);
+	if (lstate.input_offset < input.size()) {
+		return OperatorResultType::HAVE_MORE_OUTPUT;
+	}
+	lstate.input_offset = 0;
+	return OperatorResultType::NEED_MORE_INPUT;
+}
+
+static OperatorFinalizeResultType PostgresFetchByCtidFinal(ExecutionContext &context, TableFunctionInput &data_p,
+                                                           DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<PostgresFetchByCtidData>();
+	auto &gstate = data_p.global_state->Cast<PostgresFetchByCtidGlobalState>();
+	auto &lstate = data_p.local_state->Cast<PostgresFetchByCtidLocalState>();
+	if (lstate.buffer.size() > 0) {
+		PostgresFetchRows(context.client, data, gstate, lstate, output);
+	}
+	return OperatorFinalizeResultType::FINISHED;
+}
+
+PostgresFetchByCtidFunction::PostgresFetchByCtidFunction()
+    : TableFunction("postgres_fetch_by_ctid", {}, nullptr, nullptr, PostgresFetchByCtidInitGlobal,
+                    PostgresFetchByCtidInitLocal) {
+	in_out_function = PostgresFetchByCtid;
+	in_out_function_final = PostgresFetchByCtidFinal;
+}
+
+//! Whether a column is worth fetching separately - variable-length values are usually large or TOASTed
+static bool IsWideColumn(const PostgresBindData &bind_data, column_t column_id) {
+	auto &type = bind_data.types[column_id];
+	if (type.id() == LogicalTypeId::LIST &&
+	    bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+		return false;
+	}
+	return type.id() == LogicalTypeId::VARCHAR || type.id() == LogicalTypeId::BLOB || type.IsNested();
+}
+
+static optional_ptr<LogicalGet> GetLateMaterializationScan(LogicalOperator &op) {
+	if (op.type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = op.Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return nullptr;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!bind_data.GetCatalog() || bind_data.table_name.empty() || bind_data.command_only || bind_data.emit_ctid ||
+	    bind_data.use_text_protocol || bind_data.distinct || !bind_data.params.Empty()) {
+		return nullptr;
+	}
+	// the rows are fetched by a separate statement, which only sees the rows of the scan if both run in the same
+	// snapshot - under READ COMMITTED every statement takes a new snapshot, so rows that are updated or deleted in
+	// between would silently disappear from the result
+	if (bind_data.GetCatalog()->isolation_level == PostgresIsolationLevel::READ_COMMITTED) {
+		return nullptr;
+	}
+	if (!bind_data.order_by_and_limit_bind_data.order_by_clause.empty() ||
+	    !bind_data.order_by_and_limit_bind_data.limit_clause.empty()) {
+		return nullptr;
+	}
+	for (auto &column_index : get.GetColumnIds()) {
+		if (IsVirtualColumn(column_index.GetPrimaryIndex())) {
+			return nullptr;
+		}
+	}
+	return &get;
+}
+
+static unique_ptr<PostgresBindData> CreateTableData(ClientContext &context, const PostgresBindData &bind_data) {
+	auto result = make_uniq<PostgresBindData>(context);
+	result->SetCatalog(*bind_data.GetCatalog());
+	result->schema_name = bind_data.schema_name;
+	result->table_name = bind_data.table_name;
+	result->dsn = bind_data.dsn;
+	result->attach_path = bind_data.attach_path;
+	result->names = bind_data.names;
+	result->types = bind_data.types;
+	result->postgres_types = bind_data.postgres_types;
+	result->read_only = bind_data.read_only;
+	result->emit_ctid = true;
+	return result;
+}
+
+static bool TryLateMaterialization(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &op,
+                                   ColumnBindingReplacer &replacer) {
+	if (op->type != LogicalOperatorType::LOGICAL_FILTER) {
+		return false;
+	}
+	auto &filter = op->Cast<LogicalFilter>();
+	auto get = GetLateMaterializationScan(*filter.children[0]);
+	if (!get) {
+		return false;
+	}
+	auto &bind_data = get->bind_data->Cast<PostgresBindData>();
+	// the columns the filter needs are fetched by the scan
+	unordered_set<idx_t> filter_columns;
+	for (auto &expr : filter.expressions) {
+		ExpressionIterator::VisitExpression<BoundColumnRefExpression>(*expr, [&](const BoundColumnRefExpression &colref) {
+			if (colref.binding.table_index == get->table_index) {
+				filter_columns.insert(PostgresExpressionPushdown::GetColumnIndex(*get, colref.binding.column_index));
+			}
+		});
+	}
+	auto filter_bindings = filter.GetColumnBindings();
+	auto &column_ids = get->GetColumnIds();
+	unordered_map<idx_t, column_t> late_columns;
+	for (idx_t i = 0; i < filter_bindings.size(); i++) {
+		auto &binding = filter_bindings[i];
+		if (binding.table_index != get->table_index) {
+			continue;
+		}
+		auto column_index = PostgresExpressionPushdown::GetColumnIndex(*get, binding.column_index);
+		if (column_index == DConstants::INVALID_INDEX || filter_columns.find(column_index) != filter_columns.end()) {
+			continue;
+		}
+		auto column_id = column_ids[column_index].GetPrimaryIndex();
+		if (bind_data.IsRemoteExpression(column_id) ||
+		    bind_data.skipped_columns.find(column_id) != bind_data.skipped_columns.end() ||
+		    !IsWideColumn(bind_data, column_id)) {
+			continue;
+		}
+		late_columns.emplace(i, column_id);
+	}
+	if (late_columns.empty()) {
+		return false;
+	}
+
+	// the scan fetches the ctid instead of the late columns
+	for (auto &entry : late_columns) {
+		bind_data.skipped_columns.insert(entry.second);
+	}
+	bind_data.emit_ctid = true;
+	get->AddColumnId(COLUMN_IDENTIFIER_ROW_ID);
+	idx_t ctid_output = column_ids.size() - 1;
+	if (!get->projection_ids.empty()) {
+		get->projection_ids.push_back(ctid_output);
+		ctid_output = get->projection_ids.size() - 1;
+	}
+	if (!filter.projection_map.empty()) {
+		filter.projection_map.push_back(ctid_output);
+	}
+	filter.ResolveOperatorTypes();
+
+	auto fetch_data = make_uniq<PostgresFetchByCtidData>();
+	fetch_data->table_data = CreateTableData(input.context, bind_data);
+	fetch_data->fetch_column_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+	fetch_data->ctid_index = filter_bindings.size();
+	auto table_index = input.optimizer.binder.GenerateTableIndex();
+	vector<LogicalType> returned_types;
+	decltype(get->names) returned_names;
+	for (idx_t i = 0; i < filter_bindings.size(); i++) {
+		auto entry = late_columns.find(i);
+		if (entry == late_columns.end()) {
+			fetch_data->input_columns.push_back(i);
+			fetch_data->fetch_columns.push_back(DConstants::INVALID_INDEX);
+		} else {
+			fetch_data->input_columns.push_back(DConstants::INVALID_INDEX);
+			fetch_data->fetch_columns.push_back(fetch_data->fetch_column_ids.size());
+			fetch_data->fetch_column_ids.push_back(entry->second);
+		}
+		returned_types.push_back(filter.types[i]);
+		returned_names.emplace_back("__pg_fetch_" + to_string(i));
+		replacer.replacement_bindings.emplace_back(filter_bindings[i], ColumnBinding(table_index, i));
+	}
+	fetch_data->select_sql =
+	    PostgresScanFunction::GetScanQuery(*fetch_data->table_data, fetch_data->fetch_column_ids, nullptr, 0, 0);
+
+	auto fetch = make_uniq<LogicalGet>(table_index, PostgresFetchByCtidFunction(), std::move(fetch_data),
+	                                   std::move(returned_types), std::move(returned_names));
+	for (idx_t i = 0; i < fetch->returned_types.size(); i++) {
+		fetch->AddColumnId(i);
+	}
+	if (filter.has_estimated_cardinality) {
+		fetch->SetEstimatedCardinality(filter.estimated_cardinality);
+	}
+	fetch->children.push_back(std::move(op));
+	op = std::move(fetch);
+	replacer.stop_operator = op.get();
+
+	// the rows are fetched over the connection of the transaction - the scan cannot stream over it as well
+	if (bind_data.max_threads > 1 && bind_data.read_only) {
+		bind_data.requires_materialization = false;
+		bind_data.can_use_main_thread = false;
+	} else {
+		bind_data.requires_materialization = true;
+		bind_data.can_use_main_thread = true;
+	}
+	return true;
+}
+
+static void PushdownLateMaterialization(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &op,
+                                        unique_ptr<LogicalOperator> &plan) {
+	for (auto &child : op->children) {
+		PushdownLateMaterialization(input, child, plan);
+	}
+	ColumnBindingReplacer replacer;
+	if (TryLateMaterialization(input, op, replacer)) {
+		// point all references to the columns of the filter to the fetched columns
+		replacer.VisitOperator(*plan);
+	}
+}
+
+void PostgresLateMaterialization::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	Value late_materialization;
+	if (!input.context.TryGetCurrentSetting("pg_late_materialization", late_materialization) ||
+	    !BooleanValue::Get(late_materialization)) {
+		return;
+	}
+	PushdownLateMaterialization(input, plan, plan);
+}
+
+} // namespace duckdb
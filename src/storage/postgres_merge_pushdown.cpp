@@ -0,0 +1,900 @@
+#include "storage/postgres_merge_pushdown.hpp"
+
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/parser/constraints/not_null_constraint.hpp"
+#include "duckdb/parser/constraints/unique_constraint.hpp"
+#include "duckdb/planner/column_binding_map.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/operator/logical_comparison_join.hpp"
+#include "duckdb/planner/operator/logical_extension_operator.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_merge_into.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+
+#include "postgres_connection.hpp"
+#include "postgres_expression_pushdown.hpp"
+#include "postgres_scanner.hpp"
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_table_entry.hpp"
+#include "storage/postgres_transaction.hpp"
+
+namespace duckdb {
+
+PostgresStagedMerge::PostgresStagedMerge(PhysicalPlan &physical_plan, vector<LogicalType> types,
+                                         TableCatalogEntry &table, vector<unique_ptr<Expression>> expressions_p,
+                                         PostgresStagedStatement statement_p)
+    : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, std::move(types), 1), table(table),
+      expressions(std::move(expressions_p)), statement(std::move(statement_p)) {
+}
+
+//===--------------------------------------------------------------------===//
+// States
+//===--------------------------------------------------------------------===//
+class PostgresStagedMergeGlobalState : public GlobalSinkState {
+public:
+	PostgresStagedMergeGlobalState(ClientContext &context, PostgresTableEntry &table,
+	                               const vector<unique_ptr<Expression>> &expressions, PostgresCopyFormat format)
+	    : table(table), executor(context, expressions), format(format) {
+	}
+
+	PostgresTableEntry &table;
+	ExpressionExecutor executor;
+	//! The format in which the rows are copied into the staging table
+	PostgresCopyFormat format;
+	PostgresCopyState copy_state;
+	DataChunk staged_chunk;
+	DataChunk varchar_chunk;
+	string staging_table_name;
+	//! The number of rows inserted, updated or deleted by the statement
+	int64_t merge_count = 0;
+	bool copy_is_active = false;
+};
+
+static string GetStagedColumnName(idx_t index) {
+	return PostgresUtils::WriteIdentifier("c" + to_string(index));
+}
+
+static string CreateStagingTable(const string &name, const vector<unique_ptr<Expression>> &expressions) {
+	string result;
+	result = "CREATE LOCAL TEMPORARY TABLE " + PostgresUtils::QuotePostgresIdentifier(name);
+	result += "(";
+	for (idx_t i = 0; i < expressions.size(); i++) {
+		if (i > 0) {
+			result += ", ";
+		}
+		result += GetStagedColumnName(i);
+		result += " ";
+		result += PostgresUtils::TypeToString(expressions[i]->return_type);
+	}
+	result += ") ON COMMIT DROP";
+	return result;
+}
+
+unique_ptr<GlobalSinkState> PostgresStagedMerge::GetGlobalSinkState(ClientContext &context) const {
+	auto &postgres_table = table.Cast<PostgresTableEntry>();
+	auto format = PostgresCopyFormat::BINARY;
+	Value use_binary_copy;
+	if (context.TryGetCurrentSetting("pg_use_binary_copy", use_binary_copy) && !BooleanValue::Get(use_binary_copy)) {
+		format = PostgresCopyFormat::TEXT;
+	}
+	auto result = make_uniq<PostgresStagedMergeGlobalState>(context, postgres_table, expressions, format);
+
+	auto &transaction = PostgresTransaction::Get(context, postgres_table.catalog);
+	auto &connection = transaction.GetConnection();
+	result->staging_table_name = "merge_data_" + UUID::ToString(UUID::GenerateRandomUUID());
+	connection.Execute(context, CreateStagingTable(result->staging_table_name, expressions));
+
+	vector<LogicalType> staged_types;
+	for (auto &expr : expressions) {
+		staged_types.push_back(expr->return_type);
+	}
+	result->staged_chunk.Initialize(context, staged_types);
+	return std::move(result);
+}
+
+//===--------------------------------------------------------------------===//
+// Sink
+//===--------------------------------------------------------------------===//
+SinkResultType PostgresStagedMerge::Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
+	auto &gstate = input.global_state.Cast<PostgresStagedMergeGlobalState>();
+
+	gstate.staged_chunk.Reset();
+	gstate.executor.Execute(chunk, gstate.staged_chunk);
+
+	auto &transaction = PostgresTransaction::Get(context.client, gstate.table.catalog);
+	auto &connection = transaction.GetConnection();
+	if (!gstate.copy_is_active) {
+		// nothing else runs on the connection until Finalize - keep the COPY open for all chunks
+		connection.BeginCopyTo(context.client, gstate.copy_state, gstate.format, string(), gstate.staging_table_name,
+		                       vector<string>());
+		gstate.copy_is_active = true;
+	}
+	connection.CopyChunk(context.client, gstate.copy_state, gstate.staged_chunk, gstate.varchar_chunk);
+	return SinkResultType::NEED_MORE_INPUT;
+}
+
+//===--------------------------------------------------------------------===//
+// Finalize
+//===--------------------------------------------------------------------===//
+SinkFinalizeType PostgresStagedMerge::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                               OperatorSinkFinalizeInput &input) const {
+	auto &gstate = input.global_state.Cast<PostgresStagedMergeGlobalState>();
+	auto &transaction = PostgresTransaction::Get(context, gstate.table.catalog);
+	auto &connection = transaction.GetConnection();
+	if (gstate.copy_is_active) {
+		connection.FinishCopyTo(gstate.copy_state);
+		gstate.copy_is_active = false;
+	}
+	auto result =
+	    connection.Query(context, statement.ToSQL(PostgresUtils::QuotePostgresIdentifier(gstate.staging_table_name)));
+	gstate.merge_count = result->AffectedRows();
+	return SinkFinalizeType::READY;
+}
+
+//===--------------------------------------------------------------------===//
+// GetData
+//===--------------------------------------------------------------------===//
+SourceResultType PostgresStagedMerge::GetDataInternal(ExecutionContext &context, DataChunk &chunk,
+                                                      OperatorSourceInput &input) const {
+	auto &gstate = sink_state->Cast<PostgresStagedMergeGlobalState>();
+	chunk.SetChildCardinality(1);
+	chunk.data[0].SetValue(0, Value::BIGINT(gstate.merge_count));
+
+	return SourceResultType::FINISHED;
+}
+
+//===--------------------------------------------------------------------===//
+// Helpers
+//===--------------------------------------------------------------------===//
+string PostgresStagedMerge::GetName() const {
+	return "PG_STAGED_MERGE";
+}
+
+InsertionOrderPreservingMap<string> PostgresStagedMerge::ParamsToString() const {
+	InsertionOrderPreservingMap<string> result;
+	result["Table Name"] = table.name.GetIdentifierName();
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Logical Operator
+//===--------------------------------------------------------------------===//
+class LogicalPostgresStagedMerge : public LogicalExtensionOperator {
+public:
+	LogicalPostgresStagedMerge(TableCatalogEntry &table, vector<unique_ptr<Expression>> staged_expressions,
+	                           PostgresStagedStatement statement_p)
+	    : table(table), statement(std::move(statement_p)) {
+		expressions = std::move(staged_expressions);
+	}
+
+	TableCatalogEntry &table;
+	PostgresStagedStatement statement;
+
+	PhysicalOperator &CreatePlan(ClientContext &context, PhysicalPlanGenerator &planner) override {
+		auto &plan = planner.CreatePlan(*children[0]);
+		// the source is read while the rows are copied into the staging table over the connection of the transaction
+		PostgresCatalog::MaterializePostgresScans(plan);
+		auto &merge = planner.Make<PostgresStagedMerge>(types, table, std::move(expressions), std::move(statement));
+		merge.children.push_back(plan);
+		return merge;
+	}
+
+	void Serialize(Serializer &serializer) const override {
+		throw NotImplementedException("Cannot serialize Postgres staged merge");
+	}
+
+	void ResolveTypes() override {
+		types = {LogicalType::BIGINT};
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Optimizer
+//===--------------------------------------------------------------------===//
+//! The plan of a MERGE: a join of the source with a scan of the target table, with projections on top
+struct PostgresMergeInput {
+	PostgresMergeInput(LogicalMergeInto &merge, PostgresTableEntry &table) : merge(merge), table(table) {
+	}
+
+	LogicalMergeInto &merge;
+	PostgresTableEntry &table;
+	//! The projections between the MERGE and the join, from top to bottom
+	vector<reference<LogicalProjection>> projections;
+	optional_ptr<LogicalComparisonJoin> join;
+	optional_ptr<LogicalGet> target;
+	//! The index of the source in the children of the join
+	idx_t source_index = 0;
+	column_binding_set_t source_bindings;
+	//! The expressions over the source whose values are copied into the staging table
+	vector<unique_ptr<Expression>> staged_expressions;
+};
+
+//! Follow a column binding through the projections to the join - returns false if it is computed by a projection
+static bool ResolveBinding(const PostgresMergeInput &input, ColumnBinding &binding) {
+	for (auto &projection_ref : input.projections) {
+		auto &projection = projection_ref.get();
+		if (binding.table_index != projection.table_index) {
+			continue;
+		}
+		idx_t column_index = binding.column_index;
+		auto &expr = *projection.expressions[column_index];
+		if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+			return false;
+		}
+		binding = expr.Cast<BoundColumnRefExpression>().binding;
+	}
+	return true;
+}
+
+//! Copy an expression, pointing its column references at the target scan or the source directly
+//! Returns nullptr if the expression references anything else
+static unique_ptr<Expression> ResolveExpression(const PostgresMergeInput &input, const Expression &expr) {
+	auto result = expr.Copy();
+	bool resolved = true;
+	ExpressionIterator::VisitExpressionMutable<BoundColumnRefExpression>(
+	    result, [&](BoundColumnRefExpression &colref, unique_ptr<Expression> &) {
+		    if (!ResolveBinding(input, colref.binding)) {
+			    resolved = false;
+			    return;
+		    }
+		    if (colref.binding.table_index != input.target->table_index &&
+		        input.source_bindings.find(colref.binding) == input.source_bindings.end()) {
+			    resolved = false;
+		    }
+	    });
+	if (!resolved) {
+		return nullptr;
+	}
+	return result;
+}
+
+static bool IsSourceExpression(const PostgresMergeInput &input, const Expression &expr) {
+	bool source_only = true;
+	ExpressionIterator::VisitExpression<BoundColumnRefExpression>(expr, [&](const BoundColumnRefExpression &colref) {
+		if (input.source_bindings.find(colref.binding) == input.source_bindings.end()) {
+			source_only = false;
+		}
+	});
+	return source_only;
+}
+
+//! The column of the target table a resolved expression refers to, or INVALID_INDEX if it is not a plain column
+static idx_t GetTargetColumn(const PostgresMergeInput &input, const Expression &expr) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return DConstants::INVALID_INDEX;
+	}
+	auto &colref = expr.Cast<BoundColumnRefExpression>();
+	auto &get = *input.target;
+	if (colref.binding.table_index != get.table_index) {
+		return DConstants::INVALID_INDEX;
+	}
+	auto column_index = PostgresExpressionPushdown::GetColumnIndex(get, colref.binding.column_index);
+	if (column_index == DConstants::INVALID_INDEX) {
+		return DConstants::INVALID_INDEX;
+	}
+	auto column_id = get.GetColumnIds()[column_index].GetPrimaryIndex();
+	if (IsVirtualColumn(column_id) || column_id >= input.table.postgres_types.size() ||
+	    input.table.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+		return DConstants::INVALID_INDEX;
+	}
+	return column_id;
+}
+
+static string GetTargetColumnName(const PostgresMergeInput &input, idx_t column_id) {
+	return PostgresUtils::WriteIdentifier(input.table.postgres_names[column_id]);
+}
+
+static string GetTargetTableName(const PostgresMergeInput &input) {
+	auto &table = input.table;
+	return PostgresUtils::WriteIdentifier(table.schema.name.GetIdentifierName()) + "." +
+	       PostgresUtils::WriteIdentifier(table.name.GetIdentifierName());
+}
+
+//! Add a value to the staging table - returns the index of its column
+static idx_t StageExpression(ClientContext &context, PostgresMergeInput &input, unique_ptr<Expression> expr) {
+	for (idx_t i = 0; i < input.staged_expressions.size(); i++) {
+		if (input.staged_expressions[i]->Equals(*expr)) {
+			return i;
+		}
+	}
+	auto postgres_type = PostgresUtils::ToPostgresType(expr->return_type);
+	if (postgres_type != expr->return_type) {
+		expr = BoundCastExpression::AddCastToType(context, std::move(expr), postgres_type);
+	}
+	input.staged_expressions.push_back(std::move(expr));
+	return input.staged_expressions.size() - 1;
+}
+
+//! Whether the values of a type can be staged - the column type of the staging table is written by its Postgres name
+static bool CanStageType(const LogicalType &type) {
+	if (type.HasAlias()) {
+		// e.g. a user-defined type of DuckDB that does not exist in Postgres
+		return StringUtil::CIEquals(type.GetAlias(), "json");
+	}
+	switch (type.id()) {
+	case LogicalTypeId::ENUM:
+		// enums of Postgres tables are unnamed in DuckDB - their values cannot be staged as text either, as text is not
+		// implicitly cast to an enum type
+	case LogicalTypeId::STRUCT:
+	case LogicalTypeId::MAP:
+	case LogicalTypeId::UNION:
+		return false;
+	case LogicalTypeId::LIST:
+		return CanStageType(ListType::GetChildType(type));
+	default:
+		return true;
+	}
+}
+
+static bool CanStageExpressions(const PostgresMergeInput &input) {
+	for (auto &expr : input.staged_expressions) {
+		if (!CanStageType(expr->return_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool MatchMergePlan(PostgresMergeInput &input) {
+	auto &merge = input.merge;
+	auto op = merge.children[0].get();
+	while (op->type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		input.projections.push_back(op->Cast<LogicalProjection>());
+		op = op->children[0].get();
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_COMPARISON_JOIN) {
+		return false;
+	}
+	auto &join = op->Cast<LogicalComparisonJoin>();
+	// the row ids of the MERGE identify the scan of the target table
+	auto bindings = merge.children[0]->GetColumnBindings();
+	if (merge.row_id_start >= bindings.size()) {
+		return false;
+	}
+	auto row_id_binding = bindings[merge.row_id_start];
+	if (!ResolveBinding(input, row_id_binding)) {
+		return false;
+	}
+	for (idx_t i = 0; i < join.children.size(); i++) {
+		auto &child = *join.children[i];
+		if (child.type == LogicalOperatorType::LOGICAL_GET &&
+		    child.Cast<LogicalGet>().table_index == row_id_binding.table_index) {
+			input.target = child.Cast<LogicalGet>();
+			input.source_index = 1 - i;
+		}
+	}
+	if (!input.target) {
+		return false;
+	}
+	auto &get = *input.target;
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return false;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (bind_data.table_name.empty() || get.table_filters.HasFilters() || !bind_data.remote_filters.empty()) {
+		// conditions on the target table (e.g. from the ON clause) would be lost
+		return false;
+	}
+	input.join = join;
+	for (auto &binding : join.children[input.source_index]->GetColumnBindings()) {
+		input.source_bindings.insert(binding);
+	}
+	return true;
+}
+
+//! Whether the columns are exactly the columns of a UNIQUE or PRIMARY KEY constraint, none of which can be NULL
+//! NULL keys never conflict, so they would behave differently from the join of the MERGE when de-duplicating
+static bool IsNotNullUniqueKey(PostgresTableEntry &table, const vector<idx_t> &key_columns) {
+	unordered_set<idx_t> keys(key_columns.begin(), key_columns.end());
+	unordered_set<idx_t> not_null_columns;
+	bool found = false;
+	for (auto &constraint : table.GetConstraints()) {
+		if (constraint->type == ConstraintType::NOT_NULL) {
+			not_null_columns.insert(constraint->Cast<NotNullConstraint>().index.index);
+			continue;
+		}
+		if (constraint->type != ConstraintType::UNIQUE) {
+			continue;
+		}
+		auto &unique = constraint->Cast<UniqueConstraint>();
+		unordered_set<idx_t> unique_columns;
+		if (unique.HasIndex()) {
+			unique_columns.insert(unique.GetIndex().index);
+		} else {
+			for (auto &name : unique.GetColumnNames()) {
+				unique_columns.insert(table.GetColumns().GetColumn(name).Logical().index);
+			}
+		}
+		if (unique_columns == keys) {
+			if (unique.IsPrimaryKey()) {
+				return true;
+			}
+			found = true;
+		}
+	}
+	if (!found) {
+		return false;
+	}
+	for (auto key : keys) {
+		if (not_null_columns.find(key) == not_null_columns.end()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! The rows that are inserted by a MERGE action
+struct PostgresMergeInsert {
+	//! The target columns that are inserted - the remaining columns get their default value in Postgres
+	vector<idx_t> columns;
+	//! The resolved value of every column
+	vector<unique_ptr<Expression>> values;
+	//! The staged column of every value
+	vector<idx_t> staged_columns;
+};
+
+//! Resolves the target columns to the existing row and the source columns to the row proposed for insertion
+class PostgresUpsertColumnResolver : public PostgresColumnResolver {
+public:
+	PostgresUpsertColumnResolver(const PostgresMergeInput &input, const PostgresMergeInsert &insert)
+	    : input(input), insert(insert) {
+	}
+
+	string TransformColumnRef(const Expression &expr) const override {
+		auto column_id = GetTargetColumn(input, expr);
+		if (column_id != DConstants::INVALID_INDEX) {
+			return "__pg_target." + GetTargetColumnName(input, column_id);
+		}
+		return TransformExcluded(expr);
+	}
+
+	//! The source values can only be referenced through the values they are inserted as
+	string TransformExcluded(const Expression &expr) const {
+		for (idx_t i = 0; i < insert.values.size(); i++) {
+			if (insert.values[i]->Equals(expr)) {
+				return "EXCLUDED." + GetTargetColumnName(input, insert.columns[i]);
+			}
+		}
+		return string();
+	}
+
+private:
+	const PostgresMergeInput &input;
+	const PostgresMergeInsert &insert;
+};
+
+//! Stage the values of the inserted columns - they can only reference the source
+static bool PlanInsertValues(ClientContext &context, PostgresMergeInput &input, BoundMergeIntoAction &action,
+                             PostgresMergeInsert &insert) {
+	for (auto &col : input.table.GetColumns().Physical()) {
+		idx_t value_index = col.Physical().index;
+		if (!action.column_index_map.empty()) {
+			value_index = action.column_index_map[col.Physical()];
+			if (value_index == DConstants::INVALID_INDEX) {
+				continue;
+			}
+		}
+		auto &value = *action.expressions[value_index];
+		if (value.GetExpressionType() == ExpressionType::VALUE_DEFAULT) {
+			continue;
+		}
+		auto column_id = col.Logical().index;
+		if (input.table.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD ||
+		    value.return_type.IsNested()) {
+			return false;
+		}
+		auto resolved = ResolveExpression(input, value);
+		if (!resolved || !IsSourceExpression(input, *resolved)) {
+			return false;
+		}
+		insert.columns.push_back(column_id);
+		insert.staged_columns.push_back(StageExpression(context, input, resolved->Copy()));
+		insert.values.push_back(std::move(resolved));
+	}
+	return true;
+}
+
+//! Translate the ON clause into the conflict target - every key column must be compared with the value inserted
+//! into it
+static bool PlanConflictTarget(PostgresMergeInput &input, const PostgresMergeInsert &insert,
+                               vector<idx_t> &key_columns) {
+	auto &join = *input.join;
+	for (auto &condition : join.conditions) {
+		if (condition.comparison != ExpressionType::COMPARE_EQUAL &&
+		    condition.comparison != ExpressionType::COMPARE_NOT_DISTINCT_FROM) {
+			return false;
+		}
+		auto &target_side = input.source_index == 0 ? condition.right : condition.left;
+		auto &source_side = input.source_index == 0 ? condition.left : condition.right;
+		auto target = ResolveExpression(input, *target_side);
+		auto source = ResolveExpression(input, *source_side);
+		if (!target || !source || !IsSourceExpression(input, *source)) {
+			return false;
+		}
+		auto column_id = GetTargetColumn(input, *target);
+		if (column_id == DConstants::INVALID_INDEX) {
+			return false;
+		}
+		bool inserted = false;
+		for (idx_t i = 0; i < insert.columns.size(); i++) {
+			if (insert.columns[i] == column_id && insert.values[i]->Equals(*source)) {
+				inserted = true;
+				break;
+			}
+		}
+		if (!inserted) {
+			return false;
+		}
+		key_columns.push_back(column_id);
+	}
+	return !key_columns.empty() && IsNotNullUniqueKey(input.table, key_columns);
+}
+
+//! Plan the DO UPDATE SET ... [WHERE ...] clause of a WHEN MATCHED THEN UPDATE action
+static bool PlanConflictUpdate(PostgresMergeInput &input, const PostgresMergeInsert &insert,
+                               BoundMergeIntoAction &action, string &result) {
+	PostgresUpsertColumnResolver resolver(input, insert);
+	vector<string> set_list;
+	for (idx_t i = 0; i < action.columns.size(); i++) {
+		auto &value = *action.expressions[i];
+		if (value.GetExpressionType() == ExpressionType::VALUE_DEFAULT) {
+			return false;
+		}
+		auto column_id = action.columns[i].index;
+		if (input.table.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+			return false;
+		}
+		auto resolved = ResolveExpression(input, value);
+		if (!resolved) {
+			return false;
+		}
+		// values that are inserted as-is can have any type - other expressions must be evaluated the same by Postgres
+		auto value_sql = resolver.TransformExcluded(*resolved);
+		if (value_sql.empty()) {
+			value_sql = PostgresExpressionPushdown::TransformExpression(*resolved, resolver);
+		}
+		if (value_sql.empty()) {
+			return false;
+		}
+		set_list.push_back(GetTargetColumnName(input, column_id) + " = " + value_sql);
+	}
+	result = " DO UPDATE SET " + StringUtil::Join(set_list, ", ");
+	if (action.condition) {
+		auto condition = ResolveExpression(input, *action.condition);
+		if (!condition) {
+			return false;
+		}
+		auto condition_sql = PostgresExpressionPushdown::TransformPredicate(*condition, resolver);
+		if (condition_sql.empty()) {
+			return false;
+		}
+		result += " WHERE " + condition_sql;
+	}
+	return true;
+}
+
+static bool PlanUpsert(ClientContext &context, PostgresMergeInput &input, PostgresStagedStatement &result) {
+	optional_ptr<BoundMergeIntoAction> insert_action;
+	optional_ptr<BoundMergeIntoAction> update_action;
+	for (auto &entry : input.merge.actions) {
+		if (entry.second.empty()) {
+			continue;
+		}
+		if (entry.second.size() != 1) {
+			return false;
+		}
+		auto &action = *entry.second[0];
+		switch (entry.first) {
+		case MergeActionCondition::WHEN_NOT_MATCHED_BY_TARGET:
+			if (action.action_type != MergeActionType::MERGE_INSERT || action.condition) {
+				return false;
+			}
+			insert_action = action;
+			break;
+		case MergeActionCondition::WHEN_MATCHED:
+			if (action.action_type == MergeActionType::MERGE_DO_NOTHING && !action.condition) {
+				break;
+			}
+			if (action.action_type != MergeActionType::MERGE_UPDATE) {
+				return false;
+			}
+			if (!action.columns.empty()) {
+				update_action = action;
+			} else if (action.condition) {
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+	}
+	if (!insert_action) {
+		return false;
+	}
+	PostgresMergeInsert insert;
+	vector<idx_t> key_columns;
+	if (!PlanInsertValues(context, input, *insert_action, insert) || insert.columns.empty() ||
+	    !PlanConflictTarget(input, insert, key_columns)) {
+		return false;
+	}
+	string conflict_action = " DO NOTHING";
+	if (update_action && !PlanConflictUpdate(input, insert, *update_action, conflict_action)) {
+		return false;
+	}
+
+	vector<string> insert_columns;
+	vector<string> select_list;
+	for (idx_t i = 0; i < insert.columns.size(); i++) {
+		insert_columns.push_back(GetTargetColumnName(input, insert.columns[i]));
+		select_list.push_back("__pg_source." + GetStagedColumnName(insert.staged_columns[i]));
+	}
+	vector<string> conflict_target;
+	vector<string> staged_keys;
+	for (auto column_id : key_columns) {
+		conflict_target.push_back(GetTargetColumnName(input, column_id));
+		for (idx_t i = 0; i < insert.columns.size(); i++) {
+			if (insert.columns[i] == column_id) {
+				staged_keys.push_back(GetStagedColumnName(insert.staged_columns[i]));
+				break;
+			}
+		}
+	}
+	result.prefix = "INSERT INTO " + GetTargetTableName(input) + " AS __pg_target (" +
+	                StringUtil::Join(insert_columns, ", ") + ") SELECT " + StringUtil::Join(select_list, ", ") +
+	                " FROM ";
+	result.suffix = " AS __pg_source";
+	if (update_action) {
+		// Postgres cannot update a row twice in one INSERT ... ON CONFLICT - the last source row of every key wins,
+		// which is what the MERGE does as well. The staging table is filled by a single COPY, so its ctids are in the
+		// order of the source rows.
+		auto keys = StringUtil::Join(staged_keys, ", ");
+		result.prefix += "(SELECT DISTINCT ON (" + keys + ") * FROM ";
+		result.suffix = " ORDER BY " + keys + ", ctid DESC)" + result.suffix;
+	}
+	result.suffix += " ON CONFLICT (" + StringUtil::Join(conflict_target, ", ") + ")" + conflict_action;
+	return true;
+}
+
+//! Resolves the target columns to the target row and stages the source columns of a MERGE
+class PostgresMergeColumnResolver : public PostgresColumnResolver {
+public:
+	PostgresMergeColumnResolver(ClientContext &context, PostgresMergeInput &input) : context(context), input(input) {
+	}
+
+	string TransformColumnRef(const Expression &expr) const override {
+		auto column_id = GetTargetColumn(input, expr);
+		if (column_id != DConstants::INVALID_INDEX) {
+			return "__pg_target." + GetTargetColumnName(input, column_id);
+		}
+		if (!IsSourceExpression(input, expr)) {
+			return string();
+		}
+		return "__pg_source." + GetStagedColumnName(StageExpression(context, input, expr.Copy()));
+	}
+
+private:
+	ClientContext &context;
+	PostgresMergeInput &input;
+};
+
+//! Values that only depend on the source are evaluated in DuckDB and staged - other values are evaluated in Postgres
+static string TransformMergeValue(ClientContext &context, PostgresMergeInput &input, const Expression &expr,
+                                  bool is_predicate) {
+	auto resolved = ResolveExpression(input, expr);
+	if (!resolved) {
+		return string();
+	}
+	if (IsSourceExpression(input, *resolved)) {
+		if (resolved->return_type.IsNested()) {
+			return string();
+		}
+		return "__pg_source." + GetStagedColumnName(StageExpression(context, input, std::move(resolved)));
+	}
+	PostgresMergeColumnResolver resolver(context, input);
+	if (is_predicate) {
+		return PostgresExpressionPushdown::TransformPredicate(*resolved, resolver);
+	}
+	return PostgresExpressionPushdown::TransformExpression(*resolved, resolver);
+}
+
+static string TransformMergeCondition(ClientContext &context, PostgresMergeInput &input, JoinCondition &condition) {
+	auto op = PostgresExpressionPushdown::GetComparisonOperator(condition.comparison);
+	if (op.empty()) {
+		return string();
+	}
+	auto &target_side = input.source_index == 0 ? condition.right : condition.left;
+	auto &source_side = input.source_index == 0 ? condition.left : condition.right;
+	auto target = ResolveExpression(input, *target_side);
+	auto source = ResolveExpression(input, *source_side);
+	if (!target || !source) {
+		return string();
+	}
+	bool is_equality = condition.comparison == ExpressionType::COMPARE_EQUAL ||
+	                   condition.comparison == ExpressionType::COMPARE_NOT_DISTINCT_FROM;
+	auto column_id = GetTargetColumn(input, *target);
+	if (is_equality && column_id != DConstants::INVALID_INDEX && IsSourceExpression(input, *source) &&
+	    source->return_type == target->return_type && !source->return_type.IsNested()) {
+		// a column compared with a source value of the same type (e.g. a UUID key) - equality of such values is the
+		// same in Postgres for all non-nested types, so the value does not have to be supported by the expression
+		// pushdown
+		auto staged_column = StageExpression(context, input, std::move(source));
+		return "(__pg_target." + GetTargetColumnName(input, column_id) + " " + op + " __pg_source." +
+		       GetStagedColumnName(staged_column) + ")";
+	}
+	if (!PostgresExpressionPushdown::SupportedType(target->return_type) ||
+	    (!is_equality && target->return_type.id() == LogicalTypeId::VARCHAR)) {
+		// string ordering depends on the collation of the Postgres column
+		return string();
+	}
+	auto target_sql = TransformMergeValue(context, input, *target, false);
+	auto source_sql = TransformMergeValue(context, input, *source, false);
+	if (target_sql.empty() || source_sql.empty()) {
+		return string();
+	}
+	return "(" + target_sql + " " + op + " " + source_sql + ")";
+}
+
+static string TransformMergeAction(ClientContext &context, PostgresMergeInput &input, BoundMergeIntoAction &action) {
+	switch (action.action_type) {
+	case MergeActionType::MERGE_UPDATE: {
+		if (action.columns.empty()) {
+			return "DO NOTHING";
+		}
+		vector<string> set_list;
+		for (idx_t i = 0; i < action.columns.size(); i++) {
+			auto &value = *action.expressions[i];
+			auto column_id = action.columns[i].index;
+			if (value.GetExpressionType() == ExpressionType::VALUE_DEFAULT ||
+			    input.table.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+				return string();
+			}
+			auto value_sql = TransformMergeValue(context, input, value, false);
+			if (value_sql.empty()) {
+				return string();
+			}
+			set_list.push_back(GetTargetColumnName(input, column_id) + " = " + value_sql);
+		}
+		return "UPDATE SET " + StringUtil::Join(set_list, ", ");
+	}
+	case MergeActionType::MERGE_DELETE:
+		return "DELETE";
+	case MergeActionType::MERGE_INSERT: {
+		PostgresMergeInsert insert;
+		if (!PlanInsertValues(context, input, action, insert)) {
+			return string();
+		}
+		if (insert.columns.empty()) {
+			return "INSERT DEFAULT VALUES";
+		}
+		vector<string> insert_columns;
+		vector<string> values;
+		for (idx_t i = 0; i < insert.columns.size(); i++) {
+			insert_columns.push_back(GetTargetColumnName(input, insert.columns[i]));
+			values.push_back("__pg_source." + GetStagedColumnName(insert.staged_columns[i]));
+		}
+		return "INSERT (" + StringUtil::Join(insert_columns, ", ") + ") VALUES (" + StringUtil::Join(values, ", ") +
+		       ")";
+	}
+	case MergeActionType::MERGE_DO_NOTHING:
+		return "DO NOTHING";
+	default:
+		// e.g. THEN ERROR, which Postgres does not have
+		return string();
+	}
+}
+
+static bool PlanMerge(ClientContext &context, PostgresMergeInput &input, const PostgresVersion &version,
+                      PostgresStagedStatement &result) {
+	vector<string> conditions;
+	for (auto &condition : input.join->conditions) {
+		auto condition_sql = TransformMergeCondition(context, input, condition);
+		if (condition_sql.empty()) {
+			return false;
+		}
+		conditions.push_back(std::move(condition_sql));
+	}
+	if (conditions.empty()) {
+		return false;
+	}
+	string when_clauses;
+	for (auto &entry : input.merge.actions) {
+		string when;
+		switch (entry.first) {
+		case MergeActionCondition::WHEN_MATCHED:
+			when = " WHEN MATCHED";
+			break;
+		case MergeActionCondition::WHEN_NOT_MATCHED_BY_TARGET:
+			when = " WHEN NOT MATCHED";
+			break;
+		case MergeActionCondition::WHEN_NOT_MATCHED_BY_SOURCE:
+			if (version < PostgresVersion(17, 0)) {
+				// WHEN NOT MATCHED BY SOURCE was introduced in Postgres 17
+				return false;
+			}
+			when = " WHEN NOT MATCHED BY SOURCE";
+			break;
+		default:
+			return false;
+		}
+		// the actions of every condition are evaluated in order in both DuckDB and Postgres
+		for (auto &action_ptr : entry.second) {
+			auto &action = *action_ptr;
+			when_clauses += when;
+			if (action.condition) {
+				auto condition_sql = TransformMergeValue(context, input, *action.condition, true);
+				if (condition_sql.empty()) {
+					return false;
+				}
+				when_clauses += " AND " + condition_sql;
+			}
+			auto action_sql = TransformMergeAction(context, input, action);
+			if (action_sql.empty()) {
+				return false;
+			}
+			when_clauses += " THEN " + action_sql;
+		}
+	}
+	if (when_clauses.empty()) {
+		return false;
+	}
+	result.prefix = "MERGE INTO " + GetTargetTableName(input) + " AS __pg_target USING ";
+	result.suffix = " AS __pg_source ON " + StringUtil::Join(conditions, " AND ") + when_clauses;
+	return true;
+}
+
+static bool GetPushdownSetting(ClientContext &context, const string &name) {
+	Value pushdown;
+	return context.TryGetCurrentSetting(name, pushdown) && BooleanValue::Get(pushdown);
+}
+
+void PostgresMergePushdown::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	if (plan->type != LogicalOperatorType::LOGICAL_MERGE_INTO) {
+		return;
+	}
+	auto &context = input.context;
+	auto upsert_pushdown = GetPushdownSetting(context, "pg_upsert_pushdown");
+	auto merge_pushdown = GetPushdownSetting(context, "pg_merge_pushdown");
+	if (!upsert_pushdown && !merge_pushdown) {
+		return;
+	}
+	auto &merge = plan->Cast<LogicalMergeInto>();
+	auto &table = merge.table;
+	if (merge.return_chunk || table.catalog.GetCatalogType() != "postgres") {
+		return;
+	}
+	auto version = table.catalog.Cast<PostgresCatalog>().GetPostgresVersion();
+	if (version.type_v == PostgresInstanceType::REDSHIFT) {
+		return;
+	}
+	unique_ptr<PostgresMergeInput> merge_input;
+	PostgresStagedStatement statement;
+	// INSERT ... ON CONFLICT was introduced in Postgres 9.5
+	if (upsert_pushdown && version >= PostgresVersion(9, 5)) {
+		merge_input = make_uniq<PostgresMergeInput>(merge, table.Cast<PostgresTableEntry>());
+		if (!MatchMergePlan(*merge_input) || !PlanUpsert(context, *merge_input, statement) ||
+		    !CanStageExpressions(*merge_input)) {
+			merge_input.reset();
+		}
+	}
+	// MERGE was introduced in Postgres 15
+	if (!merge_input && merge_pushdown && version >= PostgresVersion(15, 0)) {
+		merge_input = make_uniq<PostgresMergeInput>(merge, table.Cast<PostgresTableEntry>());
+		if (!MatchMergePlan(*merge_input) || !PlanMerge(context, *merge_input, version, statement) ||
+		    !CanStageExpressions(*merge_input)) {
+			merge_input.reset();
+		}
+	}
+	if (!merge_input) {
+		return;
+	}
+	auto result = make_uniq<LogicalPostgresStagedMerge>(table, std::move(merge_input->staged_expressions),
+	                                                    std::move(statement));
+	result->children.push_back(std::move(merge_input->join->children[merge_input->source_index]));
+	plan = std::move(result);
+}
+
+} // namespace duckdb
@@ -1,14 +1,30 @@
 #include "storage/postgres_optimizer.hpp"
 #include "duckdb/planner/logical_operator.hpp"
 
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_distinct.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/operator/logical_limit.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/operator/logical_sample.hpp"
+#include "duckdb/planner/operator/logical_top_n.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
 
 #include "dbconnector/optimizer/order_by_and_limit_optimizer.hpp"
 #include "dbconnector/optimizer/optimizer_util.hpp"
 
+#include "postgres_expression_pushdown.hpp"
 #include "postgres_scanner.hpp"
+#include "storage/postgres_cost_planner.hpp"
+#include "storage/postgres_index_scan.hpp"
 #include "storage/postgres_index_set.hpp"
+#include "storage/postgres_join_pushdown.hpp"
+#include "storage/postgres_late_materialization.hpp"
+#include "storage/postgres_merge_pushdown.hpp"
+#include "storage/postgres_ordered_scan.hpp"
+#include "storage/postgres_partitioned_scan.hpp"
 #include "storage/postgres_schema_entry.hpp"
 #include "storage/postgres_transaction.hpp"
 #include "storage/postgres_catalog.hpp"
@@ -41,34 +57,474 @@ static void GatherPostgresScans(LogicalOperator &op, PostgresOperators &result)
 	}
 }
 
-static void DisableParallelLimit(LogicalOperator &op) {
+//! Push a percentage sample directly over a Postgres table scan into the scan as a TABLESAMPLE clause
+static void PushdownSample(unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		PushdownSample(child);
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_SAMPLE || op->children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &sample = op->Cast<LogicalSample>();
+	auto &get = op->children[0]->Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (bind_data.table_name.empty() || !bind_data.sample_clause.empty()) {
+		// TABLESAMPLE can only be applied to tables
+		return;
+	}
+	auto &options = *sample.sample_options;
+	if (!options.is_percentage) {
+		// fixed-size (reservoir) samples are taken in DuckDB
+		return;
+	}
+	string method;
+	switch (options.method) {
+	case SampleMethod::SYSTEM_SAMPLE:
+		// block-level sampling
+		method = "SYSTEM";
+		break;
+	case SampleMethod::BERNOULLI_SAMPLE:
+		method = "BERNOULLI";
+		break;
+	default:
+		return;
+	}
+	auto percentage = options.sample_size.GetValue<double>();
+	bind_data.sample_clause = StringUtil::Format(" TABLESAMPLE %s (%s)", method, Value::DOUBLE(percentage).ToString());
+	if (options.repeatable && options.seed.IsValid()) {
+		// every task uses the same seed, so the union of the ctid ranges is exactly the sample of the table
+		bind_data.sample_clause += StringUtil::Format(" REPEATABLE (%llu)", options.seed.GetIndex());
+	}
+	if (options.method == SampleMethod::BERNOULLI_SAMPLE) {
+		// BERNOULLI reads every page of the table before the ctid range is applied - splitting the scan into ctid
+		// tasks would read the entire table once per task
+		bind_data.pages_approx = 0;
+		bind_data.max_threads = 1;
+	} else if (bind_data.pages_approx > 0) {
+		// SYSTEM only reads the sampled pages, but every task still samples the entire table and only then
+		// filters on its range - only use as many tasks as the amount of sampled pages warrants
+		auto sampled_pages = static_cast<idx_t>(double(bind_data.pages_approx) * percentage / 100.0);
+		auto task_count = MinValue<idx_t>(bind_data.max_threads, sampled_pages / bind_data.pages_per_task);
+		if (task_count <= 1) {
+			bind_data.pages_approx = 0;
+			bind_data.max_threads = 1;
+		} else {
+			bind_data.pages_per_task = (bind_data.pages_approx + task_count - 1) / task_count;
+			bind_data.max_threads = task_count;
+		}
+	}
+	// the sample is fully evaluated in Postgres
+	op = std::move(op->children[0]);
+}
+
+static bool SamplePushdownEnabled(ClientContext &context) {
+	Value pushdown;
+	if (context.TryGetCurrentSetting("pg_sample_pushdown", pushdown)) {
+		return BooleanValue::Get(pushdown);
+	}
+	return true;
+}
+
+//! Resolve a Postgres scan below a chain of projections that only forward columns, mapping the given bindings of the
+//! top-most operator to the output columns of the scan
+static optional_ptr<LogicalGet> ResolveForwardedScan(LogicalOperator &op, vector<ColumnBinding> &bindings) {
+	reference<LogicalOperator> current(op);
+	while (current.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		auto &projection = current.get().Cast<LogicalProjection>();
+		for (auto &binding : bindings) {
+			if (binding.table_index != projection.table_index ||
+			    binding.column_index >= projection.expressions.size()) {
+				return nullptr;
+			}
+			auto &expr = *projection.expressions[binding.column_index];
+			if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+				return nullptr;
+			}
+			binding = expr.Cast<BoundColumnRefExpression>().binding;
+		}
+		current = *projection.children[0];
+	}
+	if (current.get().type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = current.get().Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return nullptr;
+	}
+	for (auto &binding : bindings) {
+		if (binding.table_index != get.table_index) {
+			return nullptr;
+		}
+	}
+	return &get;
+}
+
+static bool CanPushDistinct(LogicalGet &get) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (bind_data.command_only || bind_data.distinct) {
+		return false;
+	}
+	for (auto &column_index : get.GetColumnIds()) {
+		auto column_id = column_index.GetPrimaryIndex();
+		if (IsVirtualColumn(column_id)) {
+			// the ctid makes every row distinct
+			return false;
+		}
+		// only compare types that Postgres and DuckDB consider equal in the same way
+		if (bind_data.types[column_id].IsNested() ||
+		    bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Whether an aggregate returns the same result when duplicate input rows are removed
+static bool IsDuplicateInsensitive(const BoundAggregateExpression &aggr) {
+	if (aggr.IsDistinct()) {
+		return true;
+	}
+	auto &name = aggr.function.name;
+	return name == "min" || name == "max" || name == "bool_and" || name == "bool_or";
+}
+
+//! Push a DISTINCT over a Postgres scan into the scan. Postgres can then deduplicate the rows (e.g. using an index-only
+//! scan or a HashAggregate) and only transfer the unique rows
+static void PushdownDistinct(unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		PushdownDistinct(child);
+	}
+	if (op->type == LogicalOperatorType::LOGICAL_DISTINCT) {
+		auto &distinct = op->Cast<LogicalDistinct>();
+		if (distinct.distinct_type != DistinctType::DISTINCT || distinct.order_by) {
+			return;
+		}
+		vector<ColumnBinding> bindings;
+		for (auto &target : distinct.distinct_targets) {
+			if (target->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+				return;
+			}
+			bindings.push_back(target->Cast<BoundColumnRefExpression>().binding);
+		}
+		auto get = ResolveForwardedScan(*op->children[0], bindings);
+		if (!get || !CanPushDistinct(*get)) {
+			return;
+		}
+		// every column fetched by the scan must be a distinct target - otherwise it would take part in the comparison
+		unordered_set<idx_t> referenced_columns;
+		for (auto &binding : bindings) {
+			auto column_index = PostgresExpressionPushdown::GetColumnIndex(*get, binding.column_index);
+			if (column_index == DConstants::INVALID_INDEX) {
+				return;
+			}
+			referenced_columns.insert(column_index);
+		}
+		if (referenced_columns.size() != get->GetColumnIds().size()) {
+			return;
+		}
+		auto &bind_data = get->bind_data->Cast<PostgresBindData>();
+		bind_data.distinct = true;
+		if (bind_data.pages_approx == 0 || bind_data.max_threads <= 1) {
+			// a single query returns the distinct rows - the DISTINCT is fully evaluated in Postgres
+			bind_data.pages_approx = 0;
+			bind_data.max_threads = 1;
+			op = std::move(op->children[0]);
+		}
+		// with parallel ctid tasks every task deduplicates its own range and the DISTINCT in DuckDB deduplicates the
+		// union of the tasks
+		return;
+	}
+	if (op->type == LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY) {
+		// aggregates that ignore duplicates (e.g. COUNT(DISTINCT x)) can be computed over the distinct rows of the scan
+		// the aggregate is kept in DuckDB, the DISTINCT in Postgres only reduces the amount of transferred rows
+		auto &aggregate = op->Cast<LogicalAggregate>();
+		if (aggregate.expressions.empty()) {
+			return;
+		}
+		for (auto &expr : aggregate.expressions) {
+			if (expr->GetExpressionClass() != ExpressionClass::BOUND_AGGREGATE ||
+			    !IsDuplicateInsensitive(expr->Cast<BoundAggregateExpression>())) {
+				return;
+			}
+		}
+		if (aggregate.children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+			return;
+		}
+		auto &get = aggregate.children[0]->Cast<LogicalGet>();
+		if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data ||
+		    !CanPushDistinct(get)) {
+			return;
+		}
+		get.bind_data->Cast<PostgresBindData>().distinct = true;
+	}
+}
+
+static bool DistinctPushdownEnabled(ClientContext &context) {
+	Value pushdown;
+	if (context.TryGetCurrentSetting("pg_distinct_pushdown", pushdown)) {
+		return BooleanValue::Get(pushdown);
+	}
+	return true;
+}
+
+//! A Top-N over a Postgres scan - recorded before ORDER BY and LIMIT are pushed into the scan
+struct PostgresTopN {
+	PostgresTopN(LogicalTopN &top_n, LogicalGet &get) : get(get), limit(top_n.limit), offset(top_n.offset) {
+		for (auto &order : top_n.orders) {
+			orders.push_back(order.Copy());
+		}
+	}
+
+	LogicalGet &get;
+	vector<BoundOrderByNode> orders;
+	idx_t limit;
+	idx_t offset;
+};
+
+//! Top-N operators over Postgres scans, keyed by the child of the Top-N
+using postgres_top_n_map_t = reference_map_t<LogicalOperator, PostgresTopN>;
+
+static optional_ptr<LogicalGet> FindPostgresGet(LogicalOperator &op) {
+	reference<LogicalOperator> current(op);
+	while (current.get().type == LogicalOperatorType::LOGICAL_PROJECTION && current.get().children.size() == 1) {
+		current = *current.get().children[0];
+	}
+	if (current.get().type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = current.get().Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return nullptr;
+	}
+	return &get;
+}
+
+static void GatherTopN(LogicalOperator &op, postgres_top_n_map_t &result) {
+	if (op.type == LogicalOperatorType::LOGICAL_TOP_N) {
+		auto &child = *op.children[0];
+		auto get = FindPostgresGet(child);
+		if (get) {
+			result.emplace(child, PostgresTopN(op.Cast<LogicalTopN>(), *get));
+		}
+	}
+	for (auto &child : op.children) {
+		GatherTopN(*child, result);
+	}
+}
+
+static bool CanParallelizeTopN(const PostgresBindData &bind_data) {
+	return bind_data.read_only && !bind_data.use_text_protocol && bind_data.pages_approx > 0 &&
+	       bind_data.max_threads > 1;
+}
+
+//! Re-introduces a Top-N in DuckDB over a Postgres scan that had its ORDER BY and LIMIT pushed down, so that every
+//! ctid task only needs to return its local top-N rows and DuckDB merges the results of the tasks
+static void PlanParallelTopN(unique_ptr<LogicalOperator> &op, postgres_top_n_map_t &top_n_map,
+                             reference_set_t<LogicalGet> &parallel_scans) {
+	for (auto &child : op->children) {
+		if (op->type == LogicalOperatorType::LOGICAL_TOP_N) {
+			// the Top-N was not pushed into the scan
+			top_n_map.erase(*child);
+		}
+		PlanParallelTopN(child, top_n_map, parallel_scans);
+	}
+	auto entry = top_n_map.find(*op);
+	if (entry == top_n_map.end()) {
+		return;
+	}
+	auto &top_n = entry->second;
+	auto &bind_data = top_n.get.bind_data->Cast<PostgresBindData>();
+	auto &pushed_clauses = bind_data.order_by_and_limit_bind_data;
+	if (pushed_clauses.order_by_clause.empty() || pushed_clauses.limit_clause.empty() ||
+	    !CanParallelizeTopN(bind_data)) {
+		return;
+	}
+	// every task returns its first (limit + offset) rows - the offset is applied by the Top-N in DuckDB
+	pushed_clauses.limit_clause = " LIMIT " + to_string(top_n.limit + top_n.offset);
+	auto result = make_uniq<LogicalTopN>(std::move(top_n.orders), top_n.limit, top_n.offset);
+	result->children.push_back(std::move(op));
+	op = std::move(result);
+	parallel_scans.insert(top_n.get);
+	top_n_map.erase(entry);
+}
+
+static void DisableParallelLimit(LogicalOperator &op, const reference_set_t<LogicalGet> &parallel_scans) {
 	LogicalGet *get = nullptr;
 	dbconnector::BindData *bind_data = nullptr;
-	if (dbconnector::optimizer::OptimizerUtil::FindExtensionGet("postgres_scan", op, get, bind_data)) {
+	if (dbconnector::optimizer::OptimizerUtil::FindExtensionGet("postgres_scan", op, get, bind_data) &&
+	    parallel_scans.find(*get) == parallel_scans.end()) {
 		auto &pg_bind_data = bind_data->Cast<PostgresBindData>();
-		if (!pg_bind_data.order_by_and_limit_bind_data.limit_clause.empty()) {
+		auto &pushed_clauses = pg_bind_data.order_by_and_limit_bind_data;
+		if (!pushed_clauses.limit_clause.empty() ||
+		    (!pushed_clauses.order_by_clause.empty() && pg_bind_data.key_ranges.empty())) {
 			// When LIMIT is pushed down to Postgres, we must ensure single-task execution
 			// to avoid each task (whether parallel or sequential) applying the LIMIT independently.
 			// Setting pages_approx = 0 disables CTID-based task splitting, ensuring a single query.
+			// A bare LIMIT is served by a single query that stops as soon as enough rows are produced.
+			// The same holds for an ORDER BY that could not be split into ranges of the sort key.
 			pg_bind_data.pages_approx = 0;
 			pg_bind_data.max_threads = 1;
 		}
 	}
 
 	for (auto &child : op.children) {
-		DisableParallelLimit(*child);
+		DisableParallelLimit(*child, parallel_scans);
+	}
+}
+
+static bool ParallelTopNEnabled(ClientContext &context) {
+	Value parallel_top_n;
+	if (context.TryGetCurrentSetting("pg_parallel_top_n", parallel_top_n)) {
+		return BooleanValue::Get(parallel_top_n);
+	}
+	return true;
+}
+
+static bool ReferencesTable(Expression &expr, TableIndex table_index) {
+	bool result = false;
+	ExpressionIterator::VisitExpression<BoundColumnRefExpression>(
+	    expr, [&](const BoundColumnRefExpression &colref) { result |= colref.binding.table_index == table_index; });
+	return result;
+}
+
+static void PushdownProjectionExpressions(LogicalOperator &op) {
+	for (auto &child : op.children) {
+		PushdownProjectionExpressions(*child);
+	}
+	if (op.type != LogicalOperatorType::LOGICAL_PROJECTION || op.children.size() != 1 ||
+	    op.children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &projection = op.Cast<LogicalProjection>();
+	auto &get = op.children[0]->Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!bind_data.read_only || bind_data.use_text_protocol || bind_data.command_only) {
+		// the text reader resolves Postgres types by output position - keep the scan layout untouched
+		return;
+	}
+	if (bind_data.distinct) {
+		// skipping columns would change which rows are distinct
+		return;
+	}
+	bool pushed_expression = false;
+	for (auto &expr : projection.expressions) {
+		if (expr->GetExpressionClass() == ExpressionClass::BOUND_COLUMN_REF ||
+		    expr->GetExpressionClass() == ExpressionClass::BOUND_CONSTANT) {
+			continue;
+		}
+		if (!ReferencesTable(*expr, get.table_index)) {
+			continue;
+		}
+		auto sql = PostgresExpressionPushdown::TransformExpression(*expr, get, bind_data);
+		if (sql.empty()) {
+			continue;
+		}
+		// append a computed column to the scan and reference it from the projection instead
+		auto &type = expr->return_type;
+		auto column_id =
+		    bind_data.AddRemoteExpression("CAST((" + sql + ") AS " + PostgresUtils::TypeToString(type) + ")", type);
+		get.returned_types.push_back(type);
+		get.names.emplace_back(bind_data.names[column_id]);
+		get.AddColumnId(column_id);
+		idx_t output_index = get.GetColumnIds().size() - 1;
+		if (!get.projection_ids.empty()) {
+			get.projection_ids.push_back(output_index);
+			output_index = get.projection_ids.size() - 1;
+		}
+		expr = make_uniq<BoundColumnRefExpression>(expr->alias, type, ColumnBinding(get.table_index, output_index));
+		pushed_expression = true;
+	}
+	if (!pushed_expression) {
+		return;
+	}
+	// the projection is the only consumer of the scan - columns it no longer references do not need to be fetched
+	// filters are evaluated in Postgres by column name, so they do not require the column to be fetched either
+	unordered_set<idx_t> referenced_columns;
+	for (auto &expr : projection.expressions) {
+		ExpressionIterator::VisitExpression<BoundColumnRefExpression>(
+		    *expr, [&](const BoundColumnRefExpression &colref) {
+			    if (colref.binding.table_index != get.table_index) {
+				    return;
+			    }
+			    auto column_index = PostgresExpressionPushdown::GetColumnIndex(get, colref.binding.column_index);
+			    if (column_index != DConstants::INVALID_INDEX) {
+				    referenced_columns.insert(column_index);
+			    }
+		    });
+	}
+	auto &column_ids = get.GetColumnIds();
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		auto column_id = column_ids[i].GetPrimaryIndex();
+		if (referenced_columns.find(i) != referenced_columns.end() || IsVirtualColumn(column_id) ||
+		    bind_data.IsRemoteExpression(column_id)) {
+			continue;
+		}
+		bind_data.skipped_columns.insert(column_id);
 	}
 }
 
+static bool ProjectionPushdownEnabled(ClientContext &context) {
+	Value pushdown;
+	if (context.TryGetCurrentSetting("pg_projection_pushdown", pushdown)) {
+		return BooleanValue::Get(pushdown);
+	}
+	return true;
+}
+
 void PostgresOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
 	using namespace dbconnector;
+	// this must run before the scan of the target table of a MERGE is rewritten by any of the passes below
+	PostgresMergePushdown::Optimize(input, plan);
 	// look at query plan and check if we can find LIMIT/OFFSET to pushdown
 	// OptimizePostgresScanLimitPushdown(plan);
 
 	auto order_config = optimizer::OrderByAndLimitOptimizer::CreateConfig(
 	    input.context, "pg_order_pushdown", '"', query::QuoteEscapeStyle::DOUBLE_QUOTE, "postgres_scan");
+	if (SamplePushdownEnabled(input.context)) {
+		PushdownSample(plan);
+	}
+	if (DistinctPushdownEnabled(input.context)) {
+		PushdownDistinct(plan);
+	}
+	postgres_top_n_map_t top_n_map;
+	if (ParallelTopNEnabled(input.context)) {
+		GatherTopN(*plan, top_n_map);
+	}
+	postgres_sort_key_map_t sort_keys;
+	PostgresOrderedScan::GatherSortKeys(*plan, sort_keys);
+	auto cost_based = PostgresCostPlanner::Enabled(input.context);
+	postgres_order_map_t orders;
+	if (cost_based) {
+		PostgresCostPlanner::GatherOrders(*plan, orders);
+	}
 	optimizer::OrderByAndLimitOptimizer::Optimize(order_config, input, plan);
-	DisableParallelLimit(*plan);
+	reference_set_t<LogicalGet> parallel_scans;
+	if (!top_n_map.empty()) {
+		PlanParallelTopN(plan, top_n_map, parallel_scans);
+	}
+	if (!sort_keys.empty()) {
+		PostgresOrderedScan::PlanKeyRanges(input.context, sort_keys);
+	}
+	if (!orders.empty()) {
+		PostgresCostPlanner::PlanOrders(input.context, plan, orders);
+	}
+	PostgresIndexScan::PlanIndexScans(input.context, *plan);
+	PostgresPartitionedScan::PlanPartitions(input.context, *plan);
+	DisableParallelLimit(*plan, parallel_scans);
+	if (cost_based) {
+		PostgresCostPlanner::PlanFilters(input.context, *plan);
+		PostgresCostPlanner::PlanParallelism(input.context, *plan);
+	}
+	if (ProjectionPushdownEnabled(input.context)) {
+		PushdownProjectionExpressions(*plan);
+	}
+	PostgresJoinPushdown::Optimize(input, plan);
 
 	// look at the query plan and check if we can enable streaming query scans
 	PostgresOperators operators;
@@ -98,6 +554,7 @@ void PostgresOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<Logi
 			}
 		}
 	}
+	PostgresLateMaterialization::Optimize(input, plan);
 }
 
 } // namespace duckdb
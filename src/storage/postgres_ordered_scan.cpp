@@ -0,0 +1,170 @@
+#include "storage/postgres_ordered_scan.hpp"
+
+#include "duckdb/main/settings.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/operator/logical_order.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+
+#include "postgres_expression_pushdown.hpp"
+#include "postgres_scanner.hpp"
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_transaction.hpp"
+
+namespace duckdb {
+
+//! Resolve the column of a Postgres scan that a sort expression refers to, looking through projections
+static optional_ptr<LogicalGet> ResolveSortColumn(LogicalOperator &op, const Expression &expr, column_t &column_id) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return nullptr;
+	}
+	auto binding = expr.Cast<BoundColumnRefExpression>().binding;
+	reference<LogicalOperator> current(op);
+	while (current.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		auto &projection = current.get().Cast<LogicalProjection>();
+		if (binding.table_index != projection.table_index || binding.column_index >= projection.expressions.size()) {
+			return nullptr;
+		}
+		auto &child_expr = *projection.expressions[binding.column_index];
+		if (child_expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+			return nullptr;
+		}
+		binding = child_expr.Cast<BoundColumnRefExpression>().binding;
+		current = *projection.children[0];
+	}
+	if (current.get().type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = current.get().Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data ||
+	    binding.table_index != get.table_index) {
+		return nullptr;
+	}
+	auto column_index = PostgresExpressionPushdown::GetColumnIndex(get, binding.column_index);
+	if (column_index == DConstants::INVALID_INDEX) {
+		return nullptr;
+	}
+	column_id = get.GetColumnIds()[column_index].GetPrimaryIndex();
+	if (IsVirtualColumn(column_id)) {
+		return nullptr;
+	}
+	return &get;
+}
+
+void PostgresOrderedScan::GatherSortKeys(LogicalOperator &op, postgres_sort_key_map_t &result) {
+	if (op.type == LogicalOperatorType::LOGICAL_ORDER_BY) {
+		auto &order = op.Cast<LogicalOrder>();
+		column_t column_id;
+		auto get = ResolveSortColumn(*op.children[0], *order.orders[0].expression, column_id);
+		if (get) {
+			PostgresSortKey key;
+			key.column_id = column_id;
+			key.descending = order.orders[0].type == OrderType::DESCENDING;
+			key.nulls_first = order.orders[0].null_order == OrderByNullType::NULLS_FIRST;
+			result.emplace(*get, key);
+		}
+	}
+	for (auto &child : op.children) {
+		GatherSortKeys(*child, result);
+	}
+}
+
+//! Read the histogram bounds of a column from pg_stats - returns no bounds if the statistics cannot be read
+static vector<string> GetHistogramBounds(ClientContext &context, PostgresBindData &bind_data, column_t column_id) {
+	auto &transaction = PostgresTransaction::Get(context, *bind_data.GetCatalog());
+	// the bounds are converted to text so that they can be used as literals regardless of the column type
+	auto query = StringUtil::Format(
+	    R"(SELECT bound FROM (
+	SELECT histogram_bounds FROM pg_stats
+	WHERE schemaname = %s AND tablename = %s AND attname = %s
+	ORDER BY inherited DESC LIMIT 1
+) stats, unnest(stats.histogram_bounds::text::text[]) WITH ORDINALITY AS bounds(bound, idx)
+ORDER BY idx)",
+	    PostgresUtils::WriteLiteral(bind_data.schema_name), PostgresUtils::WriteLiteral(bind_data.table_name),
+	    PostgresUtils::WriteLiteral(bind_data.names[column_id]));
+	auto result = transaction.TryQueryInSavepoint(context, query);
+	vector<string> bounds;
+	if (!result) {
+		return bounds;
+	}
+	for (idx_t row = 0; row < result->Count(); row++) {
+		if (result->IsNull(row, 0)) {
+			continue;
+		}
+		bounds.push_back(result->GetString(row, 0));
+	}
+	return bounds;
+}
+
+vector<string> PostgresOrderedScan::CreateKeyRanges(PostgresBindData &bind_data, const PostgresSortKey &key,
+                                                    const vector<string> &bounds) {
+	vector<string> result;
+	if (bounds.size() < 3) {
+		return result;
+	}
+	// the first and last bound are the minimum and maximum - split at equally spaced interior bounds
+	// the histogram is equi-depth, so every range holds approximately the same amount of rows
+	auto split_count = MinValue<idx_t>(bind_data.max_threads - 1, bounds.size() - 2);
+	vector<string> splits;
+	for (idx_t i = 1; i <= split_count; i++) {
+		auto &bound = bounds[i * (bounds.size() - 1) / (split_count + 1)];
+		if (splits.empty() || splits.back() != bound) {
+			splits.push_back(bound);
+		}
+	}
+	if (splits.empty()) {
+		return result;
+	}
+	auto column = PostgresUtils::WriteIdentifier(bind_data.names[key.column_id]);
+	result.push_back(StringUtil::Format("%s < %s", column, PostgresUtils::WriteLiteral(splits[0])));
+	for (idx_t i = 1; i < splits.size(); i++) {
+		result.push_back(StringUtil::Format("%s >= %s AND %s < %s", column, PostgresUtils::WriteLiteral(splits[i - 1]),
+		                                    column, PostgresUtils::WriteLiteral(splits[i])));
+	}
+	result.push_back(StringUtil::Format("%s >= %s", column, PostgresUtils::WriteLiteral(splits.back())));
+	if (key.descending) {
+		std::reverse(result.begin(), result.end());
+	}
+	auto null_range = StringUtil::Format("%s IS NULL", column);
+	if (key.nulls_first) {
+		result.insert(result.begin(), std::move(null_range));
+	} else {
+		result.push_back(std::move(null_range));
+	}
+	return result;
+}
+
+void PostgresOrderedScan::PlanKeyRanges(ClientContext &context, postgres_sort_key_map_t &sort_keys) {
+	Value ordered_scan;
+	if (context.TryGetCurrentSetting("pg_parallel_ordered_scan", ordered_scan) && !BooleanValue::Get(ordered_scan)) {
+		return;
+	}
+	if (!Settings::Get<PreserveInsertionOrderSetting>(context)) {
+		// the results of the tasks are only concatenated in the order of their batch indexes if insertion order is
+		// preserved - the ORDER BY is then served by a single task instead
+		return;
+	}
+	for (auto &entry : sort_keys) {
+		auto &get = entry.first.get();
+		auto &key = entry.second;
+		auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+		auto &pushed_clauses = bind_data.order_by_and_limit_bind_data;
+		if (pushed_clauses.order_by_clause.empty() || !pushed_clauses.limit_clause.empty()) {
+			continue;
+		}
+		if (!bind_data.GetCatalog() || bind_data.table_name.empty() || !bind_data.read_only ||
+		    bind_data.use_text_protocol || bind_data.pages_approx == 0 || bind_data.max_threads <= 1) {
+			continue;
+		}
+		if (bind_data.types[key.column_id].IsNested() ||
+		    bind_data.postgres_types[key.column_id].info != PostgresTypeAnnotation::STANDARD) {
+			continue;
+		}
+		auto bounds = GetHistogramBounds(context, bind_data, key.column_id);
+		bind_data.key_ranges = CreateKeyRanges(bind_data, key, bounds);
+		if (!bind_data.key_ranges.empty()) {
+			bind_data.max_threads = MinValue<idx_t>(bind_data.max_threads, bind_data.key_ranges.size());
+		}
+	}
+}
+
+} // namespace duckdb
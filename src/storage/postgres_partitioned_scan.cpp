@@ -0,0 +1,210 @@
+#include "storage/postgres_partitioned_scan.hpp"
+
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+#include "postgres_expression_pushdown.hpp"
+#include "postgres_scanner.hpp"
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_index_scan.hpp"
+#include "storage/postgres_transaction.hpp"
+
+namespace duckdb {
+
+//! Columns with more distinct values are not split into a task per value
+static constexpr idx_t MAX_PARTITION_VALUES = 256;
+//! Columns are only split into a task per value if no value is estimated to hold more than this fraction of the rows
+//! Every task reads its rows through the index - for more frequent values the parallel ctid ranges are cheaper
+static constexpr double MAX_PARTITION_FRACTION = 0.05;
+
+static bool PartitionedScanEnabled(ClientContext &context) {
+	Value partitioned_scan;
+	if (context.TryGetCurrentSetting("pg_partitioned_scan", partitioned_scan)) {
+		return BooleanValue::Get(partitioned_scan);
+	}
+	return true;
+}
+
+//! Whether values of the type can be converted from their Postgres text representation (in the ISO DateStyle)
+static bool IsPartitionType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::VARCHAR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool CanPartitionScan(const PostgresBindData &bind_data) {
+	if (!bind_data.GetCatalog() || !bind_data.GetTable() || bind_data.table_name.empty() || bind_data.command_only ||
+	    !bind_data.read_only || bind_data.use_text_protocol) {
+		return false;
+	}
+	// the values are read in the transaction before the scan starts - the tasks must see the same snapshot
+	if (bind_data.GetCatalog()->isolation_level == PostgresIsolationLevel::READ_COMMITTED) {
+		return false;
+	}
+	if (bind_data.pages_approx == 0 || bind_data.max_threads <= 1 || !bind_data.key_ranges.empty() ||
+	    !bind_data.ctid_tasks.empty() || !bind_data.sample_clause.empty()) {
+		return false;
+	}
+	auto &pushed_clauses = bind_data.order_by_and_limit_bind_data;
+	return pushed_clauses.order_by_clause.empty() && pushed_clauses.limit_clause.empty();
+}
+
+//! Whether the statistics of the column estimate that every value (and NULL) holds a small fraction of the rows
+//! This avoids the lookup of the distinct values at plan time for columns with few values (e.g. booleans)
+static bool HasSmallPartitions(ClientContext &context, PostgresBindData &bind_data, column_t column_id) {
+	auto &transaction = PostgresTransaction::Get(context, *bind_data.GetCatalog());
+	auto stats = transaction.Query(StringUtil::Format(
+	    R"(SELECT pg_class.reltuples, stats.null_frac, stats.n_distinct,
+       COALESCE(array_length(stats.most_common_freqs, 1), 0),
+       COALESCE((SELECT max(freq) FROM unnest(stats.most_common_freqs) AS mcf(freq)), 0),
+       COALESCE((SELECT sum(freq) FROM unnest(stats.most_common_freqs) AS mcf(freq)), 0)
+FROM pg_stats stats
+JOIN pg_namespace ON (pg_namespace.nspname=stats.schemaname)
+JOIN pg_class ON (pg_class.relnamespace=pg_namespace.oid AND pg_class.relname=stats.tablename)
+WHERE stats.schemaname = %s AND stats.tablename = %s AND stats.attname = %s
+ORDER BY stats.inherited DESC LIMIT 1)",
+	    PostgresUtils::WriteLiteral(bind_data.schema_name), PostgresUtils::WriteLiteral(bind_data.table_name),
+	    PostgresUtils::WriteLiteral(bind_data.names[column_id])));
+	if (stats->Count() == 0) {
+		// the table has not been analyzed
+		return false;
+	}
+	auto reltuples = stats->GetDouble(0, 0);
+	auto null_frac = stats->GetDouble(0, 1);
+	auto n_distinct = stats->GetDouble(0, 2);
+	auto mcv_count = stats->GetDouble(0, 3);
+	auto max_mcv_freq = stats->GetDouble(0, 4);
+	auto mcv_freq = stats->GetDouble(0, 5);
+	if (reltuples <= 0) {
+		return false;
+	}
+	auto distinct = n_distinct >= 0 ? n_distinct : -n_distinct * reltuples;
+	if (distinct > double(MAX_PARTITION_VALUES)) {
+		return false;
+	}
+	// the values that are not among the most common values are assumed to be evenly distributed
+	auto other_freq = MaxValue<double>(1 - null_frac - mcv_freq, 0);
+	auto max_other_freq = distinct > mcv_count ? other_freq / (distinct - mcv_count) : 0;
+	auto max_freq = MaxValue<double>(MaxValue<double>(max_mcv_freq, max_other_freq), null_frac);
+	return max_freq <= MAX_PARTITION_FRACTION;
+}
+
+//! Read the distinct values of an indexed column by repeatedly looking up the next value in the index
+//! Returns false if the column has more than MAX_PARTITION_VALUES values, or if the values cannot be read
+static bool GetDistinctValues(ClientContext &context, PostgresBindData &bind_data, column_t column_id,
+                              vector<string> &result) {
+	auto column = PostgresUtils::WriteIdentifier(bind_data.names[column_id]);
+	auto table = PostgresUtils::WriteIdentifier(bind_data.schema_name) + "." +
+	             PostgresUtils::WriteIdentifier(bind_data.table_name);
+	auto query = StringUtil::Format(
+	    R"(WITH RECURSIVE partition_values(value) AS (
+	(SELECT %s FROM %s WHERE %s IS NOT NULL ORDER BY %s LIMIT 1)
+	UNION ALL
+	SELECT (SELECT %s FROM %s WHERE %s > partition_values.value ORDER BY %s LIMIT 1)
+	FROM partition_values WHERE partition_values.value IS NOT NULL
+)
+SELECT value::text FROM partition_values WHERE value IS NOT NULL LIMIT %llu)",
+	    column, table, column, column, column, table, column, column, MAX_PARTITION_VALUES + 1);
+	auto &transaction = PostgresTransaction::Get(context, *bind_data.GetCatalog());
+	// the text representation of dates depends on the DateStyle of the session (e.g. "SQL, DMY") - read them as ISO
+	auto values = transaction.TryQueryInSavepoint(context, query, "SET LOCAL DateStyle = 'ISO, YMD'");
+	if (!values || values->Count() > MAX_PARTITION_VALUES) {
+		return false;
+	}
+	for (idx_t row = 0; row < values->Count(); row++) {
+		result.push_back(values->GetString(row, 0));
+	}
+	return true;
+}
+
+static void PlanPartition(ClientContext &context, LogicalAggregate &aggregate) {
+	if (aggregate.groups.size() != 1 || aggregate.grouping_sets.size() > 1 ||
+	    aggregate.groups[0]->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return;
+	}
+	auto &child = *aggregate.children[0];
+	if (child.type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &get = child.Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name.GetIdentifierName()) || !get.bind_data) {
+		return;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!CanPartitionScan(bind_data)) {
+		return;
+	}
+	auto &binding = aggregate.groups[0]->Cast<BoundColumnRefExpression>().binding;
+	if (binding.table_index != get.table_index) {
+		return;
+	}
+	auto column_index = PostgresExpressionPushdown::GetColumnIndex(get, binding.column_index);
+	if (column_index == DConstants::INVALID_INDEX) {
+		return;
+	}
+	auto column_id = get.GetColumnIds()[column_index].GetPrimaryIndex();
+	if (IsVirtualColumn(column_id) || bind_data.IsRemoteExpression(column_id) ||
+	    !IsPartitionType(bind_data.types[column_id]) ||
+	    bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+		return;
+	}
+	// without an index every lookup of the next value would scan the table
+	if (!PostgresIndexScan::HasIndex(context, bind_data, "btree", bind_data.names[column_id])) {
+		return;
+	}
+	if (!HasSmallPartitions(context, bind_data, column_id)) {
+		// keep the scan split into ctid ranges
+		return;
+	}
+	vector<string> values;
+	if (!GetDistinctValues(context, bind_data, column_id, values) || values.size() < 2) {
+		return;
+	}
+	auto column = PostgresUtils::WriteIdentifier(bind_data.names[column_id]);
+	auto &type = bind_data.types[column_id];
+	vector<Value> partition_values;
+	for (auto &value : values) {
+		Value partition_value(value);
+		if (!partition_value.DefaultTryCastAs(type)) {
+			// e.g. dates before the common era, which Postgres and DuckDB format differently
+			return;
+		}
+		partition_values.push_back(std::move(partition_value));
+	}
+	for (idx_t i = 0; i < values.size(); i++) {
+		// ISO dates are read as year-month-day by Postgres, regardless of the DateStyle of the task connection
+		bind_data.key_ranges.push_back(StringUtil::Format("%s = %s", column, PostgresUtils::WriteLiteral(values[i])));
+		bind_data.partition_values.push_back(std::move(partition_values[i]));
+	}
+	bind_data.key_ranges.push_back(StringUtil::Format("%s IS NULL", column));
+	bind_data.partition_values.push_back(Value(type));
+	bind_data.partition_column = column_id;
+	bind_data.max_threads = MinValue<idx_t>(bind_data.max_threads, bind_data.key_ranges.size());
+}
+
+static void PlanPartitionsInternal(ClientContext &context, LogicalOperator &op) {
+	for (auto &child : op.children) {
+		PlanPartitionsInternal(context, *child);
+	}
+	if (op.type == LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY) {
+		PlanPartition(context, op.Cast<LogicalAggregate>());
+	}
+}
+
+void PostgresPartitionedScan::PlanPartitions(ClientContext &context, LogicalOperator &op) {
+	if (!PartitionedScanEnabled(context)) {
+		return;
+	}
+	PlanPartitionsInternal(context, op);
+}
+
+} // namespace duckdb
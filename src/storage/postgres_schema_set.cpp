@@ -99,7 +99,7 @@ void PostgresSchemaSet::LoadEntriesInformationSchema(ClientContext &context, Pos
 	// empty for now
 	string enum_types_query = "SELECT NULL, NULL, NULL, NULL LIMIT 0;\n";
 	string composite_types_query = "SELECT NULL, NULL, NULL, NULL, NULL LIMIT 0;\n";
-	string index_query = "SELECT NULL, NULL, NULL LIMIT 0;\n";
+	string index_query = "SELECT NULL, NULL, NULL, NULL, NULL, NULL, NULL LIMIT 0;\n";
 
 	auto full_query = schema_query + tables_query + enum_types_query + composite_types_query + index_query;
 
@@ -7,6 +7,7 @@
 #include "storage/postgres_transaction.hpp"
 #include "duckdb/storage/statistics/base_statistics.hpp"
 #include "duckdb/storage/table_storage_info.hpp"
+#include "duckdb/parser/constraints/not_null_constraint.hpp"
 #include "duckdb/parser/constraints/unique_constraint.hpp"
 #include "postgres_scanner.hpp"
 
@@ -22,7 +23,9 @@ PostgresTableEntry::PostgresTableEntry(Catalog &catalog, SchemaCatalogEntry &sch
 		postgres_types.push_back(PostgresUtils::CreateEmptyPostgresType(col.GetType()));
 		postgres_names.push_back(col.GetName().GetIdentifierName());
 	}
+	// a newly created table is empty
 	approx_num_pages.store(0, std::memory_order_release);
+	approx_num_rows.store(0, std::memory_order_release);
 }
 
 PostgresTableEntry::PostgresTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, PostgresTableInfo &info)
@@ -30,10 +33,62 @@ PostgresTableEntry::PostgresTableEntry(Catalog &catalog, SchemaCatalogEntry &sch
       postgres_names(std::move(info.postgres_names)) {
 	D_ASSERT(postgres_types.size() == columns.LogicalColumnCount());
 	approx_num_pages.store(info.approx_num_pages, std::memory_order_release);
+	approx_num_rows.store(info.approx_num_rows, std::memory_order_release);
+}
+
+void PostgresTableEntry::LoadStatistics(ClientContext &context) {
+	for (auto &col : columns.Logical()) {
+		column_statistics.push_back(BaseStatistics::CreateUnknown(col.GetType()).ToUnique());
+	}
+	// NOT NULL is enforced by Postgres - this is the only information about NULL values that is exact
+	for (auto &constraint : constraints) {
+		if (constraint->type == ConstraintType::NOT_NULL) {
+			auto &not_null = constraint->Cast<NotNullConstraint>();
+			column_statistics[not_null.index.index]->Set(StatsInfo::CANNOT_HAVE_NULL_VALUES);
+		}
+	}
+	// pg_stats is computed from a sample of the table (by ANALYZE) - the histogram bounds are not the real minimum
+	// and maximum, so only the number of distinct values is used, which only affects cardinality estimates
+	auto &transaction = Transaction::Get(context, catalog).Cast<PostgresTransaction>();
+	auto result = transaction.Query(StringUtil::Format(
+	    R"(SELECT DISTINCT ON (stats.attname) stats.attname, stats.n_distinct, pg_class.reltuples
+FROM pg_stats stats
+JOIN pg_namespace ON (pg_namespace.nspname=stats.schemaname)
+JOIN pg_class ON (pg_class.relnamespace=pg_namespace.oid AND pg_class.relname=stats.tablename)
+WHERE stats.schemaname = %s AND stats.tablename = %s
+ORDER BY stats.attname, stats.inherited DESC)",
+	    PostgresUtils::WriteLiteral(schema.name.GetIdentifierName()),
+	    PostgresUtils::WriteLiteral(name.GetIdentifierName())));
+	unordered_map<string, idx_t> column_indexes;
+	for (idx_t c = 0; c < postgres_names.size(); c++) {
+		column_indexes[postgres_names[c]] = c;
+	}
+	for (idx_t row = 0; row < result->Count(); row++) {
+		auto entry = column_indexes.find(result->GetString(row, 0));
+		if (entry == column_indexes.end() || result->IsNull(row, 1)) {
+			continue;
+		}
+		// a negative n_distinct is the number of distinct values divided by the number of rows
+		auto n_distinct = result->GetDouble(row, 1);
+		auto reltuples = result->GetDouble(row, 2);
+		auto distinct_count = n_distinct >= 0 ? n_distinct : -n_distinct * reltuples;
+		if (distinct_count >= 1) {
+			column_statistics[entry->second]->SetDistinctCount(static_cast<idx_t>(distinct_count));
+		}
+	}
 }
 
 unique_ptr<BaseStatistics> PostgresTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
-	return nullptr;
+	if (column_id >= columns.LogicalColumnCount()) {
+		// e.g. the ctid
+		return nullptr;
+	}
+	lock_guard<mutex> guard(statistics_lock);
+	if (!statistics_loaded) {
+		LoadStatistics(context);
+		statistics_loaded = true;
+	}
+	return column_statistics[column_id]->ToUnique();
 }
 
 void PostgresTableEntry::BindUpdateConstraints(Binder &binder, LogicalGet &, LogicalProjection &, LogicalUpdate &,
@@ -60,6 +115,7 @@ TableFunction PostgresTableEntry::GetScanFunction(ClientContext &context, unique
 	result->read_only = transaction.IsReadOnly();
 	PostgresScanFunction::PrepareBind(pg_catalog.GetPostgresVersion(), context, *result,
 	                                  approx_num_pages.load(std::memory_order_acquire));
+	result->SetTableRows(approx_num_rows.load(std::memory_order_acquire));
 
 	bind_data = std::move(result);
 	auto function = PostgresScanFunction();
@@ -137,6 +193,15 @@ static bool CopyRequiresText(const LogicalType &type, const PostgresType &pg_typ
 }
 
 PostgresCopyFormat PostgresTableEntry::GetCopyFormat(ClientContext &context) {
+	vector<PhysicalIndex> column_indexes;
+	for (idx_t c = 0; c < columns.LogicalColumnCount(); c++) {
+		column_indexes.emplace_back(c);
+	}
+	return GetCopyFormat(context, column_indexes);
+}
+
+PostgresCopyFormat PostgresTableEntry::GetCopyFormat(ClientContext &context,
+                                                     const vector<PhysicalIndex> &column_indexes) {
 	Value use_binary_copy;
 	if (context.TryGetCurrentSetting("pg_use_binary_copy", use_binary_copy)) {
 		if (!BooleanValue::Get(use_binary_copy)) {
@@ -144,8 +209,8 @@ PostgresCopyFormat PostgresTableEntry::GetCopyFormat(ClientContext &context) {
 		}
 	}
 	D_ASSERT(postgres_types.size() == columns.LogicalColumnCount());
-	for (idx_t c = 0; c < postgres_types.size(); c++) {
-		if (CopyRequiresText(columns.GetColumn(LogicalIndex(c)).GetType(), postgres_types[c])) {
+	for (auto &index : column_indexes) {
+		if (CopyRequiresText(columns.GetColumn(LogicalIndex(index.index)).GetType(), postgres_types[index.index])) {
 			return PostgresCopyFormat::TEXT;
 		}
 	}
@@ -37,7 +37,8 @@ SELECT pg_namespace.oid AS namespace_id, relname, relpages, attname,
     attnum, pg_attribute.attnotnull AS notnull, NULL constraint_id,
     NULL constraint_type, NULL constraint_key, type_ns.nspname AS type_schema,
     col_desc.description AS column_comment,
-    tbl_desc.description AS table_comment
+    tbl_desc.description AS table_comment,
+    GREATEST(reltuples, pg_stat_user_tables.n_live_tup)::BIGINT AS reltuples
 FROM pg_class
 JOIN pg_namespace ON relnamespace = pg_namespace.oid
 JOIN pg_attribute ON pg_class.oid=pg_attribute.attrelid
@@ -45,13 +46,14 @@ JOIN pg_type ON atttypid=pg_type.oid
 JOIN pg_namespace type_ns ON pg_type.typnamespace = type_ns.oid
 LEFT JOIN pg_description col_desc ON col_desc.objoid=pg_class.oid AND col_desc.objsubid=pg_attribute.attnum
 LEFT JOIN pg_description tbl_desc ON tbl_desc.objoid=pg_class.oid AND tbl_desc.objsubid=0
+LEFT JOIN pg_stat_user_tables ON pg_stat_user_tables.relid=pg_class.oid
 WHERE attnum > 0 AND relkind IN ('r', 'v', 'm', 'f', 'p') ${CONDITION}
 UNION ALL
 SELECT pg_namespace.oid AS namespace_id, relname, NULL relpages, NULL attname, NULL type_name,
     NULL type_modifier, NULL ndim, NULL attnum, NULL AS notnull,
     pg_constraint.oid AS constraint_id, contype AS constraint_type,
     conkey AS constraint_key, NULL AS type_schema,
-    NULL AS column_comment, NULL AS table_comment
+    NULL AS column_comment, NULL AS table_comment, NULL AS reltuples
 FROM pg_class
 JOIN pg_namespace ON relnamespace = pg_namespace.oid
 JOIN pg_constraint ON (pg_class.oid=pg_constraint.conrelid)
@@ -80,7 +82,7 @@ SELECT table_schema AS namespace_id, table_name AS relname, 0 AS relpages, colum
     data_type AS type_name, -1 AS type_modifier, 0 AS ndim, ordinal_position AS attnum,
     CASE WHEN is_nullable = 'NO' THEN 't' ELSE 'f' END AS notnull,
     NULL AS constraint_id, NULL AS constraint_type, NULL AS constraint_key,
-    NULL AS type_schema, NULL AS column_comment, NULL AS table_comment
+    NULL AS type_schema, NULL AS column_comment, NULL AS table_comment, NULL AS reltuples
 FROM information_schema.columns
 WHERE table_schema NOT IN ('information_schema', 'pg_catalog', 'pg_toast') ${CONDITION}
 ORDER BY table_schema, table_name, ordinal_position;
@@ -187,6 +189,7 @@ void PostgresTableSet::CreateEntries(PostgresTransaction &transaction, PostgresR
 			}
 			info = make_uniq<PostgresTableInfo>(schema, table_name);
 			info->approx_num_pages = result.IsNull(row, 2) ? 0 : result.GetInt64(row, 2);
+			info->approx_num_rows = result.IsNull(row, 15) ? -1 : result.GetInt64(row, 15);
 			// Read table-level comment from column 14
 			if (!result.IsNull(row, 14)) {
 				info->create_info->comment = Value(result.GetString(row, 14));
@@ -256,6 +259,7 @@ unique_ptr<PostgresTableInfo> PostgresTableSet::GetTableInfo(PostgresTransaction
 		AddColumnOrConstraint(&transaction, &schema, *result, row, *table_info);
 	}
 	table_info->approx_num_pages = result->IsNull(0, 2) ? 0 : result->GetInt64(0, 2);
+	table_info->approx_num_rows = result->IsNull(0, 15) ? -1 : result->GetInt64(0, 15);
 	// Read table-level comment from 14
 	if (!result->IsNull(0, 14)) {
 		table_info->create_info->comment = Value(result->GetString(0, 14));
@@ -278,6 +282,7 @@ unique_ptr<PostgresTableInfo> PostgresTableSet::GetTableInfo(ClientContext &cont
 		AddColumnOrConstraint(nullptr, nullptr, *result, row, *table_info);
 	}
 	table_info->approx_num_pages = result->IsNull(0, 2) ? 0 : result->GetInt64(0, 2);
+	table_info->approx_num_rows = result->IsNull(0, 15) ? -1 : result->GetInt64(0, 15);
 	// Read table-level comment
 	if (!result->IsNull(0, 14)) {
 		table_info->create_info->comment = Value(result->GetString(0, 14));
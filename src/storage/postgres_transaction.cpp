@@ -27,6 +27,7 @@ optional_ptr<ClientContext> PostgresTransaction::GetContext() {
 
 void PostgresTransaction::Start() {
 	transaction_state = PostgresTransactionState::TRANSACTION_NOT_YET_STARTED;
+	exported_snapshot = false;
 }
 void PostgresTransaction::Commit() {
 	if (transaction_state == PostgresTransactionState::TRANSACTION_STARTED) {
@@ -41,14 +42,27 @@ void PostgresTransaction::Commit() {
 	for (auto &entry : to_promote) {
 		entry.first.get().PromoteStalenessSignature(std::move(entry.second));
 	}
+	lock_guard<mutex> l(rollback_tables_lock);
+	rollback_tables.clear();
 }
 void PostgresTransaction::Rollback() {
 	if (transaction_state == PostgresTransactionState::TRANSACTION_STARTED) {
 		transaction_state = PostgresTransactionState::TRANSACTION_FINISHED;
 		GetConnectionRaw().Execute(GetContext(), "ROLLBACK");
 	}
-	lock_guard<mutex> l(pending_signatures_lock);
-	pending_signatures.clear();
+	{
+		lock_guard<mutex> l(pending_signatures_lock);
+		pending_signatures.clear();
+	}
+	vector<string> tables;
+	{
+		lock_guard<mutex> l(rollback_tables_lock);
+		tables = std::move(rollback_tables);
+	}
+	if (!tables.empty()) {
+		// the connection is no longer in a transaction - the tables are dropped immediately
+		GetConnectionRaw().TryQuery(GetContext(), "DROP TABLE IF EXISTS " + StringUtil::Join(tables, ", "));
+	}
 }
 
 string PostgresTransaction::GetBeginTransactionQuery() {
@@ -137,6 +151,24 @@ vector<unique_ptr<PostgresResult>> PostgresTransaction::ExecuteQueries(ClientCon
 	return con.ExecuteQueries(context, queries);
 }
 
+unique_ptr<PostgresResult> PostgresTransaction::TryQueryInSavepoint(ClientContext &context, const string &query,
+                                                                    const string &local_settings) {
+	auto &con = GetConnection();
+	// a failing statement aborts the enclosing transaction - run the query in a savepoint so we can recover
+	con.Execute(context, "SAVEPOINT __duckdb_try_query");
+	if (!local_settings.empty()) {
+		con.Execute(context, local_settings);
+	}
+	auto result = con.TryQuery(context, query);
+	if (!result || !local_settings.empty()) {
+		// rolling back to the savepoint also restores the settings of the transaction
+		con.Execute(context, "ROLLBACK TO SAVEPOINT __duckdb_try_query; RELEASE SAVEPOINT __duckdb_try_query");
+		return result;
+	}
+	con.Execute(context, "RELEASE SAVEPOINT __duckdb_try_query");
+	return result;
+}
+
 optional_ptr<CatalogEntry> PostgresTransaction::ReferenceEntry(shared_ptr<CatalogEntry> &entry) {
 	auto &ref = *entry;
 	lock_guard<mutex> l(referenced_entries_lock);
@@ -149,6 +181,11 @@ void PostgresTransaction::StageStalenessSignature(PostgresCatalogSet &catalog_se
 	pending_signatures.emplace_back(catalog_set, std::move(signature));
 }
 
+void PostgresTransaction::DropOnRollback(string qualified_table_name) {
+	lock_guard<mutex> l(rollback_tables_lock);
+	rollback_tables.push_back(std::move(qualified_table_name));
+}
+
 string PostgresTransaction::GetTemporarySchema() {
 	if (temporary_schema.empty()) {
 		auto result = Query("SELECT nspname FROM pg_namespace WHERE oid = pg_my_temp_schema();");
@@ -8,6 +8,7 @@
 #include "duckdb/planner/operator/logical_update.hpp"
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_transaction.hpp"
+#include "postgres_binary_writer.hpp"
 #include "postgres_connection.hpp"
 #include "duckdb/common/types/uuid.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
@@ -25,10 +26,13 @@ PostgresUpdate::PostgresUpdate(PhysicalPlan &physical_plan, LogicalOperator &op,
 //===--------------------------------------------------------------------===//
 class PostgresUpdateGlobalState : public GlobalSinkState {
 public:
-	explicit PostgresUpdateGlobalState(PostgresTableEntry &table) : table(table), update_count(0) {
+	PostgresUpdateGlobalState(PostgresTableEntry &table, PostgresCopyFormat format)
+	    : table(table), format(format), update_count(0) {
 	}
 
 	PostgresTableEntry &table;
+	//! The format in which the updated rows are copied into the temporary table
+	PostgresCopyFormat format;
 	PostgresCopyState copy_state;
 	DataChunk insert_chunk;
 	DataChunk varchar_chunk;
@@ -46,7 +50,8 @@ public:
 	}
 };
 
-string CreateUpdateTable(const string &name, PostgresTableEntry &table, const vector<PhysicalIndex> &index) {
+string CreateUpdateTable(const string &name, PostgresTableEntry &table, const vector<PhysicalIndex> &index,
+                         PostgresCopyFormat format) {
 	string result;
 	result = "CREATE LOCAL TEMPORARY TABLE " + PostgresUtils::QuotePostgresIdentifier(name);
 	result += "(";
@@ -58,11 +63,16 @@ string CreateUpdateTable(const string &name, PostgresTableEntry &table, const ve
 		result += PostgresUtils::TypeToString(col.GetType());
 		result += ", ";
 	}
-	result += "__page_id_string VARCHAR) ON COMMIT DROP;";
+	if (format == PostgresCopyFormat::BINARY) {
+		result += "__page_id TID) ON COMMIT DROP;";
+	} else {
+		result += "__page_id_string VARCHAR) ON COMMIT DROP;";
+	}
 	return result;
 }
 
-string GetUpdateSQL(const string &name, PostgresTableEntry &table, const vector<PhysicalIndex> &index) {
+string GetUpdateSQL(const string &name, PostgresTableEntry &table, const vector<PhysicalIndex> &index,
+                    PostgresCopyFormat format) {
 	string result;
 	result = "UPDATE ";
 	result += PostgresUtils::WriteIdentifier(table.schema.name.GetIdentifierName()) + ".";
@@ -82,7 +92,11 @@ string GetUpdateSQL(const string &name, PostgresTableEntry &table, const vector<
 	result += " FROM " + PostgresUtils::QuotePostgresIdentifier(name);
 	result += " WHERE ";
 	result += PostgresUtils::WriteIdentifier(table.name.GetIdentifierName());
-	result += ".ctid=__page_id_string::TID";
+	if (format == PostgresCopyFormat::BINARY) {
+		result += ".ctid=__page_id";
+	} else {
+		result += ".ctid=__page_id_string::TID";
+	}
 	return result;
 }
 
@@ -90,20 +104,24 @@ unique_ptr<GlobalSinkState> PostgresUpdate::GetGlobalSinkState(ClientContext &co
 	auto &postgres_table = table.Cast<PostgresTableEntry>();
 
 	auto &transaction = PostgresTransaction::Get(context, postgres_table.catalog);
-	auto result = make_uniq<PostgresUpdateGlobalState>(postgres_table);
+	// stage the ctids as native tids (and the values in their binary representation) unless a column requires text
+	auto format = postgres_table.GetCopyFormat(context, columns);
+	auto result = make_uniq<PostgresUpdateGlobalState>(postgres_table, format);
 	auto &connection = transaction.GetConnection();
 	// create a temporary table to stream the update data into
 	result->update_table_name = "update_data_" + UUID::ToString(UUID::GenerateRandomUUID());
-	connection.Execute(context, CreateUpdateTable(result->update_table_name, postgres_table, columns));
+	connection.Execute(context, CreateUpdateTable(result->update_table_name, postgres_table, columns, format));
 	// generate the final UPDATE sql
-	result->update_sql = GetUpdateSQL(result->update_table_name, postgres_table, columns);
+	result->update_sql = GetUpdateSQL(result->update_table_name, postgres_table, columns, format);
 	// initialize the insertion chunk
 	vector<LogicalType> insert_types;
 	for (idx_t i = 0; i < columns.size(); i++) {
 		auto &col = table.GetColumn(LogicalIndex(columns[i].index));
 		insert_types.push_back(col.GetType());
 	}
-	insert_types.push_back(LogicalType::VARCHAR);
+	if (format == PostgresCopyFormat::TEXT) {
+		insert_types.push_back(LogicalType::VARCHAR);
+	}
 	result->insert_chunk.Initialize(context, insert_types);
 	return std::move(result);
 }
@@ -126,25 +144,8 @@ SinkResultType PostgresUpdate::Sink(ExecutionContext &context, DataChunk &chunk,
 		auto &binding = expressions[i]->Cast<BoundReferenceExpression>();
 		gstate.insert_chunk.data[i].Reference(chunk.data[binding.Index()]);
 	}
-	// convert our row ids back into ctids
 	auto &row_identifiers = chunk.data[chunk.ColumnCount() - 1];
-	auto &ctid_vector = gstate.insert_chunk.data[gstate.insert_chunk.ColumnCount() - 1];
 	auto row_data = FlatVector::GetDataMutable<row_t>(row_identifiers);
-	auto varchar_data = FlatVector::GetDataMutable<string_t>(ctid_vector);
-
-	for (idx_t r = 0; r < chunk.size(); r++) {
-		// extract the ctid from the row id
-		auto row_in_page = row_data[r] & 0xFFFF;
-		auto page_index = row_data[r] >> 16;
-
-		string ctid_string;
-		ctid_string += "'(";
-		ctid_string += to_string(page_index);
-		ctid_string += ",";
-		ctid_string += to_string(row_in_page);
-		ctid_string += ")'";
-		varchar_data[r] = StringVector::AddString(ctid_vector, ctid_string);
-	}
 	gstate.insert_chunk.SetChildCardinality(chunk.size());
 
 	auto &transaction = PostgresTransaction::Get(context.client, gstate.table.catalog);
@@ -153,11 +154,41 @@ SinkResultType PostgresUpdate::Sink(ExecutionContext &context, DataChunk &chunk,
 		// begin the COPY TO
 		string schema_name;
 		vector<string> column_names;
-		connection.BeginCopyTo(context.client, gstate.copy_state, PostgresCopyFormat::TEXT, schema_name,
-		                       gstate.update_table_name, column_names);
+		connection.BeginCopyTo(context.client, gstate.copy_state, gstate.format, schema_name, gstate.update_table_name,
+		                       column_names);
 		gstate.copy_is_active = true;
 	}
-	connection.CopyChunk(context.client, gstate.copy_state, gstate.insert_chunk, gstate.varchar_chunk);
+	if (gstate.format == PostgresCopyFormat::BINARY) {
+		// write the row ids as binary tids directly - they are never formatted as strings
+		PostgresBinaryWriter writer(gstate.copy_state);
+		for (idx_t r = 0; r < chunk.size(); r++) {
+			writer.BeginRow(expressions.size() + 1);
+			for (idx_t c = 0; c < expressions.size(); c++) {
+				writer.WriteValue(gstate.insert_chunk.data[c], r);
+			}
+			writer.WriteCtid(row_data[r]);
+			writer.FinishRow();
+		}
+		connection.CopyData(writer);
+	} else {
+		// convert our row ids back into ctids
+		auto &ctid_vector = gstate.insert_chunk.data[gstate.insert_chunk.ColumnCount() - 1];
+		auto varchar_data = FlatVector::GetDataMutable<string_t>(ctid_vector);
+		for (idx_t r = 0; r < chunk.size(); r++) {
+			// extract the ctid from the row id
+			auto row_in_page = row_data[r] & 0xFFFF;
+			auto page_index = row_data[r] >> 16;
+
+			string ctid_string;
+			ctid_string += "'(";
+			ctid_string += to_string(page_index);
+			ctid_string += ",";
+			ctid_string += to_string(row_in_page);
+			ctid_string += ")'";
+			varchar_data[r] = StringVector::AddString(ctid_vector, ctid_string);
+		}
+		connection.CopyChunk(context.client, gstate.copy_state, gstate.insert_chunk, gstate.varchar_chunk);
+	}
 	if (!keep_copy_alive) {
 		gstate.FinishCopyTo(connection);
 	}